@@ -0,0 +1,322 @@
+'''
+Run the job files made by an experiment's gen-sub.py on the local machine instead of submitting them with sbatch.
+
+Every job file is expanded into its replicates exactly like slurm does (same seeds, run directories, and parameters).
+Runs are scheduled across the local cores within a core and memory budget, and runs whose data.csv already
+reaches MAX_GENS (or that wrote a termination.csv) are skipped, so an interrupted experiment picks up where it left off when run again.
+Unfinished runs carry on from their last checkpoint (see SNAP_INTERVAL), or start over if they have none.
+'''
+
+import argparse, os, sys, errno, glob, re, shutil, subprocess, time
+
+# how often (in seconds) we check on running jobs
+poll_interval = 1.0
+
+'''
+This is functionally equivalent to the mkdir -p [fname] bash command
+'''
+def mkdir_p(path):
+    try:
+        os.makedirs(path)
+    except OSError as exc: # Python >2.5
+        if exc.errno == errno.EEXIST and os.path.isdir(path):
+            pass
+        else: raise
+
+'''
+Convert a slurm style memory request (e.g. 4G, 500M, 4096) into bytes (no unit means megabytes).
+'''
+def parse_memory(text):
+    units = {"K":2**10, "M":2**20, "G":2**30, "T":2**40}
+    text = text.strip().upper().rstrip("B")
+    if text[-1] in units:
+        return int(float(text[:-1]) * units[text[-1]])
+    return int(float(text) * units["M"])
+
+def format_memory(num_bytes):
+    return f"{num_bytes / 2**30:.1f}G"
+
+'''
+Total physical memory on this machine (in bytes).
+'''
+def machine_memory():
+    try:
+        return os.sysconf("SC_PAGE_SIZE") * os.sysconf("SC_PHYS_PAGES")
+    except (ValueError, OSError, AttributeError):
+        return 2**40
+
+'''
+Read a 'set NAME value' entry from a config file (None if it is not there).
+'''
+def read_cfg_value(cfg_path, name):
+    if not os.path.isfile(cfg_path):
+        return None
+    with open(cfg_path, "r") as fp:
+        for line in fp:
+            parts = line.split("#")[0].split()
+            if len(parts) >= 3 and parts[0] == "set" and parts[1] == name:
+                return parts[2]
+    return None
+
+'''
+Given the path to a job file made by gen-sub.py, pull out everything needed to run its replicates.
+'''
+def parse_job_file(job_path):
+    with open(job_path, "r") as fp:
+        content = fp.read()
+
+    def find(pattern):
+        match = re.search(pattern, content, re.MULTILINE)
+        if match == None:
+            print(f"ERROR: could not find {pattern} in {job_path}")
+            sys.exit(1)
+        return match.group(1).strip()
+
+    array_range = find(r"^#SBATCH --array=(\S+)")
+    first, last = array_range.split("-") if "-" in array_range else (array_range, array_range)
+
+    job = {
+        "name":os.path.splitext(os.path.basename(job_path))[0],
+        "array_ids":list(range(int(first), int(last) + 1)),
+        "memory":parse_memory(find(r"^#SBATCH --mem=(\S+)")),
+        "seed_offset":int(find(r"^JOB_SEED_OFFSET=(\S+)")),
+        "exec":find(r"^EXEC=(\S+)"),
+        "config_dir":find(r"^CONFIG_DIR=(\S+)"),
+        "run_dir":find(r"^RUN_DIR=(\S+)"),
+        "run_params":find(r'^RUN_PARAMS="(.*)"')
+    }
+    return job
+
+'''
+Turn a job file into one run per array id (the same seeds and run directories slurm would use).
+'''
+def expand_job(job, args):
+    params_list = job["run_params"].split()
+    params = {params_list[i].lstrip("-"):params_list[i+1] for i in range(0, len(params_list) - 1, 2)}
+    cfg_path = os.path.join(job["config_dir"], "Dia.cfg")
+
+    def setting(name, default):
+        if name in params: return params[name]
+        value = read_cfg_value(cfg_path, name)
+        return default if value == None else value
+
+    max_gens = setting("MAX_GENS", None)
+    islands = int(setting("ISLANDS", "1"))
+    cores = int(setting("THREADS", "1")) * islands
+
+    runs = []
+    for array_id in job["array_ids"]:
+        seed = job["seed_offset"] + array_id - 1
+        run_dir = job["run_dir"].replace("${SEED}", str(seed))
+        output_dir = os.path.join(run_dir, params.get("OUTPUT_DIR", "./"))
+
+        # islands each write their own data.csv
+        if islands > 1:
+            data_files = [os.path.join(output_dir, f"island_{k}", "data.csv") for k in range(islands)]
+        else:
+            data_files = [os.path.join(output_dir, "data.csv")]
+
+        runs.append({
+            "name":os.path.basename(os.path.normpath(run_dir)),
+            "seed":seed,
+            "run_dir":run_dir,
+            "config_dir":job["config_dir"],
+            "exec":args.exec if args.exec else os.path.join(job["config_dir"], job["exec"]),
+            "run_params":f"-SEED {seed} {job['run_params']}" if "SEED" not in params else job["run_params"],
+            "params":dict(params, SEED=str(seed), OUTPUT_DIR=os.path.join(os.path.normpath(output_dir), "")),
+            "max_gens":max_gens,
+            "data_files":data_files,
+            "cores":cores,
+            "memory":args.run_memory if args.run_memory else job["memory"]
+        })
+    return runs
+
+'''
+Is a data file written all the way up to (and including) the last generation?
+'''
+def data_complete(data_path, max_gens):
+    # runs with DATA_FORMAT 1 only write data.col, which gets its footer index once the run finishes
+    col_path = os.path.join(os.path.dirname(data_path), "data.col")
+    if not os.path.isfile(data_path) and os.path.isfile(col_path):
+        with open(col_path, "rb") as fp:
+            fp.seek(0, os.SEEK_END)
+            if fp.tell() < 8:
+                return False
+            fp.seek(-8, os.SEEK_END)
+            return fp.read(8) == b"DIACOLIX"
+    if max_gens == None or not os.path.isfile(data_path):
+        return False
+    with open(data_path, "r") as fp:
+        lines = [line for line in fp.read().split("\n") if line.strip() != ""]
+    if len(lines) < 2:
+        return False
+    header = [field.strip() for field in lines[0].split(",")]
+    if not "gen" in header:
+        return False
+    last = lines[-1].split(",")
+    gen_i = header.index("gen")
+    return len(last) == len(header) and last[gen_i].strip() == str(max_gens)
+
+def run_complete(run):
+    # runs that stopped early on a termination criterion say so in termination.csv
+    def stopped(data_path):
+        return os.path.isfile(os.path.join(os.path.dirname(data_path), "termination.csv"))
+    return all(stopped(path) or data_complete(path, run["max_gens"]) for path in run["data_files"])
+
+'''
+Set up a run's directory like the slurm job script does, then start it in the background.
+'''
+def start_run(run):
+    mkdir_p(run["run_dir"])
+
+    copied = []
+    for cfg in glob.glob(os.path.join(run["config_dir"], "*.cfg")):
+        dst = os.path.join(run["run_dir"], os.path.basename(cfg))
+        shutil.copy(cfg, dst)
+        copied.append(dst)
+
+    # pick an unfinished run back up where its last checkpoint left it
+    # (absolute, since the run itself starts inside run_dir)
+    run_params = run["run_params"]
+    checkpoint = os.path.abspath(os.path.join(run["params"]["OUTPUT_DIR"], "checkpoint.bin"))
+    resuming = os.path.isfile(checkpoint)
+    if resuming:
+        run_params += f" --resume {checkpoint}"
+
+    with open(os.path.join(run["run_dir"], "cmd.log"), "a" if resuming else "w") as fp:
+        fp.write(f"{run['exec']} {run_params}\n")
+
+    log = open(os.path.join(run["run_dir"], "run.log"), "a" if resuming else "w")
+    proc = subprocess.Popen([os.path.abspath(run["exec"])] + run_params.split(), cwd=run["run_dir"], stdout=log, stderr=subprocess.STDOUT)
+    return {"run":run, "proc":proc, "log":log, "copied":copied, "start":time.time()}
+
+def finish_run(active):
+    active["log"].close()
+    for path in active["copied"]:
+        if os.path.isfile(path): os.remove(path)
+
+'''
+Write the runs as dia_world --batch manifests, one per config directory, since a batch reads its defaults from the Dia.cfg
+in the directory it is started from. With a single config directory the manifest goes to 'path', otherwise to
+path_1, path_2, ... (before the extension). Returns the manifests written with their config directory and executable.
+'''
+def write_manifests(runs, path):
+    groups = {}
+    for run in runs:
+        groups.setdefault(run["config_dir"], []).append(run)
+
+    root, ext = os.path.splitext(path)
+    written = []
+    for k, (config_dir, group) in enumerate(groups.items()):
+        manifest = path if len(groups) == 1 else f"{root}_{k + 1}{ext}"
+        with open(manifest, "w") as fp:
+            for run in group:
+                # absolute output directories, so the batch can start from the config directory
+                params = dict(run["params"], OUTPUT_DIR=os.path.join(os.path.abspath(run["params"]["OUTPUT_DIR"]), ""))
+                fp.write(" ".join([f"-{field} {params[field]}" for field in sorted(params)]) + "\n")
+        written.append((manifest, config_dir, group[0]["exec"], len(group)))
+    return written
+
+def format_time(seconds):
+    seconds = int(seconds)
+    return f"{seconds // 3600}h{(seconds % 3600) // 60:02d}m{seconds % 60:02d}s"
+
+def main():
+    parser = argparse.ArgumentParser(description="Run slurm job files on the local machine.")
+    parser.add_argument("--job_dir", type=str, default="./job-files", help="Where are the job files made by gen-sub.py?")
+    parser.add_argument("--cores", type=int, default=os.cpu_count(), help="How many cores can we use at once?")
+    parser.add_argument("--memory", type=str, default=None, help="How much memory can we use at once (e.g. 16G)? Defaults to all of it.")
+    parser.add_argument("--run_memory", type=str, default=None, help="Memory each run needs (defaults to the job file's --mem request)")
+    parser.add_argument("--exec", type=str, default=None, help="Executable to run (defaults to EXEC inside CONFIG_DIR)")
+    parser.add_argument("--manifest", type=str, default=None, help="Write the unfinished runs as dia_world --batch manifests (one per config directory) instead of running them")
+    parser.add_argument("--dry_run", action="store_true", help="Only report what would run")
+
+    # Load command line arguments
+    args = parser.parse_args()
+    if args.run_memory: args.run_memory = parse_memory(args.run_memory)
+    mem_budget = parse_memory(args.memory) if args.memory else machine_memory()
+    core_budget = max(1, args.cores)
+
+    job_files = sorted(glob.glob(os.path.join(args.job_dir, "*.sb")))
+    if len(job_files) == 0:
+        print(f"No job files found in {args.job_dir}")
+        sys.exit(1)
+
+    # Expand every job file into its runs
+    runs = []
+    for job_path in job_files:
+        runs += expand_job(parse_job_file(job_path), args)
+
+    pending = [run for run in runs if not run_complete(run)]
+    print(f'Found {len(runs)} runs across {len(job_files)} job files, {len(runs) - len(pending)} already complete!')
+    print(f'Budget: {core_budget} cores, {format_memory(mem_budget)} memory')
+
+    if args.manifest:
+        written = write_manifests(pending, args.manifest)
+        for manifest, config_dir, exec_path, count in written:
+            if not os.path.isfile(os.path.join(config_dir, "Dia.cfg")):
+                print(f"WARNING: {config_dir} has no Dia.cfg, {manifest} runs on the built in defaults")
+            print(f'Wrote {count} runs to {manifest}, start it from its config directory:')
+            print(f'  cd {os.path.abspath(config_dir)} && {os.path.abspath(exec_path)} --batch {os.path.abspath(manifest)}')
+        return
+
+    if args.dry_run:
+        for run in pending:
+            print(f"{run['name']}: {run['exec']} {run['run_params']}")
+        return
+
+    active = []
+    finished = 0
+    failed = []
+    start_time = time.time()
+    try:
+        while len(pending) or len(active):
+            # start every run that fits in what is left of the budget (in order)
+            cores_used = sum(a["run"]["cores"] for a in active)
+            mem_used = sum(a["run"]["memory"] for a in active)
+            while len(pending):
+                run = pending[0]
+                fits = cores_used + run["cores"] <= core_budget and mem_used + run["memory"] <= mem_budget
+                # a run larger than the whole budget still gets to go alone
+                if not fits and len(active):
+                    break
+                if not fits:
+                    print(f"WARNING: {run['name']} needs more than the budget, running it alone")
+                active.append(start_run(pending.pop(0)))
+                cores_used += run["cores"]
+                mem_used += run["memory"]
+
+            time.sleep(poll_interval)
+
+            for a in [a for a in active if a["proc"].poll() != None]:
+                active.remove(a)
+                finish_run(a)
+                finished += 1
+                code = a["proc"].returncode
+                if code != 0 or not run_complete(a["run"]):
+                    failed.append(a["run"]["name"])
+
+                elapsed = time.time() - start_time
+                per_hour = finished * 3600.0 / elapsed
+                eta = (len(pending) + len(active)) * elapsed / finished
+                status = "done" if code == 0 else f"FAILED ({code})"
+                print(f'[{finished}/{finished + len(pending) + len(active)}] {a["run"]["name"]} {status} in {format_time(time.time() - a["start"])} | {per_hour:.2f} runs/hour | ETA {format_time(eta)}')
+                sys.stdout.flush()
+
+    except KeyboardInterrupt:
+        print("Interrupted, stopping active runs (they carry on from their last checkpoint next time)")
+        for a in active:
+            a["proc"].terminate()
+            a["proc"].wait()
+            finish_run(a)
+        sys.exit(1)
+
+    elapsed = time.time() - start_time
+    if finished:
+        print(f'Finished {finished} runs in {format_time(elapsed)} ({finished * 3600.0 / elapsed:.2f} runs/hour)')
+    if len(failed):
+        print(f'{len(failed)} runs did not complete: {" ".join(failed)}')
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
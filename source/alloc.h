@@ -0,0 +1,264 @@
+/// Allocation accounting: with DIA_ALLOC_CHECK defined (make dia_world_alloccheck) the global operator new/delete are
+/// replaced to count allocations, bytes and peak live memory per generation phase and call site, written to alloc.csv
+/// Without it the phase and site tags compile to nothing
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+///< standard headers
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+
+///< system headers
+#ifdef DIA_ALLOC_CHECK
+#include <malloc.h>
+#endif
+
+///< experiment headers
+#include "timing.h"
+
+class Alloc
+{
+  // object types we are using in this class
+  public:
+    // call site categories
+    enum Site : size_t
+    {
+      OTHER = 0,     // everything not tagged
+      MATRIX,        // PopFitMat and PopGenomes
+      SELECTION,     // the selection scheme (outside of its matrices)
+      DIAGNOSTIC,    // evaluating solutions on the diagnostic
+      SITES
+    };
+
+    // allocations outside of any phase (setup and teardown)
+    static constexpr size_t NONE = Timing::PHASES;
+    static constexpr size_t SLOTS = Timing::PHASES + 1;
+
+#ifdef DIA_ALLOC_CHECK
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    // what was counted for a phase and site
+    struct Count
+    {
+      uint64_t allocs = 0;
+      uint64_t frees = 0;
+      uint64_t bytes = 0;
+    };
+
+    /// Tags the calling thread's allocations with a phase until it ends (then the previous phase is back)
+    class PhaseTag
+    {
+      public:
+        PhaseTag() {;}
+        PhaseTag(const size_t phase) {if constexpr (ENABLED) {prev = current_phase; current_phase = phase; armed = true;}}
+        PhaseTag(PhaseTag && other) : prev(other.prev), armed(other.armed) {other.armed = false;}
+        PhaseTag(const PhaseTag &) = delete;
+        ~PhaseTag() {Stop();}
+
+        void Stop() {if constexpr (ENABLED) {if(armed) {current_phase = prev; armed = false;}}}
+
+      private:
+        size_t prev = NONE;
+        bool armed = false;
+    };
+
+    /// Tags the calling thread's allocations with a call site until it ends (then the previous site is back)
+    class SiteTag
+    {
+      public:
+        SiteTag(const size_t site) {if constexpr (ENABLED) {prev = current_site; current_site = site;}}
+        SiteTag(const SiteTag &) = delete;
+        ~SiteTag() {if constexpr (ENABLED) {current_site = prev;}}
+
+      private:
+        size_t prev = OTHER;
+    };
+
+
+  public:
+
+    ///< helper functions
+
+    // counts of one phase and site, and of everything
+    static Count Get(const size_t phase, const size_t site);
+    static Count GetTotal();
+
+    // bytes live right now, the most ever live, and the most live while a phase was allocating
+    static int64_t GetLive() {return live.load(std::memory_order_relaxed);}
+    static int64_t GetPeak() {return peak.load(std::memory_order_relaxed);}
+    static int64_t GetPeak(const size_t phase) {return phase_peak[phase].load(std::memory_order_relaxed);}
+
+    // one row per phase and site that allocated
+    static void Write(const std::string & path);
+
+    static const char * SiteName(const size_t site);
+    static const char * PhaseName(const size_t phase) {return phase < Timing::PHASES ? Timing::Name(phase) : "none";}
+
+    ///< called by the replaced operator new and delete (nothing in here may allocate)
+    ///< frees are charged to the phase and site doing the free, not to the ones that allocated
+
+    static void OnAlloc(const size_t bytes);
+    static void OnFree(const size_t bytes);
+
+  private:
+    // raise a peak to v
+    static void Raise(std::atomic<int64_t> & max, const int64_t v);
+
+  private:
+    static inline thread_local size_t current_phase = NONE;
+    static inline thread_local size_t current_site = OTHER;
+
+    static inline std::atomic<uint64_t> allocs[SLOTS][SITES];
+    static inline std::atomic<uint64_t> frees[SLOTS][SITES];
+    static inline std::atomic<uint64_t> bytes[SLOTS][SITES];
+    static inline std::atomic<int64_t> phase_peak[SLOTS];
+    static inline std::atomic<int64_t> live{0};
+    static inline std::atomic<int64_t> peak{0};
+};
+
+Alloc::Count Alloc::Get(const size_t phase, const size_t site)
+{
+  Count c;
+  c.allocs = allocs[phase][site].load(std::memory_order_relaxed);
+  c.frees = frees[phase][site].load(std::memory_order_relaxed);
+  c.bytes = bytes[phase][site].load(std::memory_order_relaxed);
+  return c;
+}
+
+Alloc::Count Alloc::GetTotal()
+{
+  Count total;
+  for(size_t p = 0; p < SLOTS; ++p)
+  {
+    for(size_t s = 0; s < SITES; ++s)
+    {
+      const Count c = Get(p, s);
+      total.allocs += c.allocs; total.frees += c.frees; total.bytes += c.bytes;
+    }
+  }
+  return total;
+}
+
+void Alloc::Write(const std::string & path)
+{
+  std::ofstream os(path);
+  if(!os)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;
+    return;
+  }
+
+  os << "phase,site,allocs,frees,bytes,phase_peak_bytes\n";
+  for(size_t p = 0; p < SLOTS; ++p)
+  {
+    for(size_t s = 0; s < SITES; ++s)
+    {
+      const Count c = Get(p, s);
+      if(c.allocs == 0 && c.frees == 0) {continue;}
+      os << PhaseName(p) << "," << SiteName(s) << "," << c.allocs << "," << c.frees << "," << c.bytes << "," << GetPeak(p) << "\n";
+    }
+  }
+}
+
+const char * Alloc::SiteName(const size_t site)
+{
+  static const char * names[SITES] = {"other", "matrix", "selection", "diagnostic"};
+  return site < SITES ? names[site] : "unknown";
+}
+
+void Alloc::OnAlloc(const size_t n)
+{
+  const size_t p = current_phase, s = current_site;
+  allocs[p][s].fetch_add(1, std::memory_order_relaxed);
+  bytes[p][s].fetch_add(n, std::memory_order_relaxed);
+
+  const int64_t now = live.fetch_add(static_cast<int64_t>(n), std::memory_order_relaxed) + static_cast<int64_t>(n);
+  Raise(peak, now);
+  Raise(phase_peak[p], now);
+}
+
+void Alloc::OnFree(const size_t n)
+{
+  frees[current_phase][current_site].fetch_add(1, std::memory_order_relaxed);
+  live.fetch_sub(static_cast<int64_t>(n), std::memory_order_relaxed);
+}
+
+void Alloc::Raise(std::atomic<int64_t> & max, const int64_t v)
+{
+  int64_t seen = max.load(std::memory_order_relaxed);
+  while(seen < v && !max.compare_exchange_weak(seen, v, std::memory_order_relaxed)) {;}
+}
+
+#ifdef DIA_ALLOC_CHECK
+
+///< replaced global allocation functions (bytes are the usable size malloc hands out, glibc)
+
+void * operator new(std::size_t n)
+{
+  void * p = std::malloc(n ? n : 1);
+  if(p == nullptr) {throw std::bad_alloc();}
+  Alloc::OnAlloc(malloc_usable_size(p));
+  return p;
+}
+
+void * operator new(std::size_t n, const std::nothrow_t &) noexcept
+{
+  void * p = std::malloc(n ? n : 1);
+  if(p) {Alloc::OnAlloc(malloc_usable_size(p));}
+  return p;
+}
+
+void * operator new(std::size_t n, std::align_val_t al)
+{
+  // aligned_alloc wants a multiple of the alignment
+  const size_t a = static_cast<size_t>(al);
+  void * p = std::aligned_alloc(a, ((n ? n : 1) + a - 1) / a * a);
+  if(p == nullptr) {throw std::bad_alloc();}
+  Alloc::OnAlloc(malloc_usable_size(p));
+  return p;
+}
+
+void * operator new(std::size_t n, std::align_val_t al, const std::nothrow_t &) noexcept
+{
+  const size_t a = static_cast<size_t>(al);
+  void * p = std::aligned_alloc(a, ((n ? n : 1) + a - 1) / a * a);
+  if(p) {Alloc::OnAlloc(malloc_usable_size(p));}
+  return p;
+}
+
+void operator delete(void * p) noexcept
+{
+  if(p == nullptr) {return;}
+  Alloc::OnFree(malloc_usable_size(p));
+  std::free(p);
+}
+
+void * operator new[](std::size_t n) {return operator new(n);}
+void * operator new[](std::size_t n, const std::nothrow_t & t) noexcept {return operator new(n, t);}
+void * operator new[](std::size_t n, std::align_val_t al) {return operator new(n, al);}
+void * operator new[](std::size_t n, std::align_val_t al, const std::nothrow_t & t) noexcept {return operator new(n, al, t);}
+
+void operator delete[](void * p) noexcept {operator delete(p);}
+void operator delete(void * p, std::size_t) noexcept {operator delete(p);}
+void operator delete[](void * p, std::size_t) noexcept {operator delete(p);}
+void operator delete(void * p, std::align_val_t) noexcept {operator delete(p);}
+void operator delete[](void * p, std::align_val_t) noexcept {operator delete(p);}
+void operator delete(void * p, std::size_t, std::align_val_t) noexcept {operator delete(p);}
+void operator delete[](void * p, std::size_t, std::align_val_t) noexcept {operator delete(p);}
+void operator delete(void * p, const std::nothrow_t &) noexcept {operator delete(p);}
+void operator delete[](void * p, const std::nothrow_t &) noexcept {operator delete(p);}
+void operator delete(void * p, std::align_val_t, const std::nothrow_t &) noexcept {operator delete(p);}
+void operator delete[](void * p, std::align_val_t, const std::nothrow_t &) noexcept {operator delete(p);}
+
+#endif
+
+#endif
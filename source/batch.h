@@ -0,0 +1,217 @@
+/// Batch runner that executes many runs (replicates x conditions) concurrently inside one process
+/// Every line of a manifest is one run, written with the same -NAME value flags as the command line
+
+#ifndef BATCH_H
+#define BATCH_H
+
+///< standard headers
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+///< empirical headers
+#include "base/Ptr.h"
+#include "base/vector.h"
+
+///< experiment headers
+#include "config.h"
+#include "island.h"
+#include "pool.h"
+#include "world.h"
+
+class Batch
+{
+  // object types we are using in this class
+  public:
+    // config overrides for one run (name, value)
+    using overrides_t = emp::vector<std::pair<std::string, std::string>>;
+
+    // one manifest line
+    struct run_t
+    {
+      size_t line = 0;
+      overrides_t overrides;
+    };
+
+
+  public:
+
+    Batch(DiaConfig & _config) : config(_config) {;}
+
+    ///< helper functions
+
+    /**
+     * Parse Line function:
+     *
+     * Reads the overrides on one manifest line, e.g. "-SEED 130001 -SELECTION 6 -OUTPUT_DIR data/RUN_C0_130001/".
+     * Blank lines and lines starting with '#' hold no run.
+     *
+     * @param text Manifest line.
+     * @param overrides Where the (name, value) pairs go.
+     * @param err Reason the line could not be read.
+     *
+     * @return True if the line was read (even if it holds no run).
+     */
+    static bool ParseLine(const std::string & text, overrides_t & overrides, std::string & err);
+
+    /**
+     * Load function:
+     *
+     * Reads every run in a manifest and checks that each one names known settings and its own OUTPUT_DIR.
+     *
+     * @param manifest Path to the manifest.
+     *
+     * @return True if every line was fine (nothing is queued otherwise).
+     */
+    bool Load(const std::string & manifest);
+
+    // number of runs loaded
+    size_t GetSize() const {return runs.size();}
+
+    // run everything on a work-stealing pool of 'jobs' threads
+    void Run(const size_t jobs);
+
+  private:
+    // one whole run (called by a pool worker)
+    void RunOne(const run_t & run);
+
+  private:
+    // base configurations (Dia.cfg + command line), every run starts from a copy
+    DiaConfig & config;
+    // runs from the manifest
+    emp::vector<run_t> runs;
+};
+
+bool Batch::ParseLine(const std::string & text, overrides_t & overrides, std::string & err)
+{
+  overrides.clear();
+
+  std::istringstream is(text);
+  std::string name;
+  while(is >> name)
+  {
+    // rest of the line is a comment
+    if(name[0] == '#') {break;}
+
+    if(name.size() < 2 || name[0] != '-')
+    {
+      err = "expected -NAME, found '" + name + "'";
+      return false;
+    }
+
+    std::string value;
+    if(!(is >> value))
+    {
+      err = "missing value for " + name;
+      return false;
+    }
+
+    overrides.emplace_back(name.substr(1), value);
+  }
+
+  return true;
+}
+
+bool Batch::Load(const std::string & manifest)
+{
+  std::ifstream is(manifest);
+  if(!is)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN MANIFEST " << manifest << std::endl;
+    return false;
+  }
+
+  std::string text; size_t line = 0; bool good = true;
+  emp::vector<std::string> dirs;
+  while(std::getline(is, text))
+  {
+    ++line;
+
+    run_t run; std::string err;
+    run.line = line;
+    if(!ParseLine(text, run.overrides, err))
+    {
+      std::cerr << "ERROR: " << manifest << ":" << line << ": " << err << std::endl;
+      good = false;
+      continue;
+    }
+    if(run.overrides.empty()) {continue;}
+
+    std::string dir = config.OUTPUT_DIR();
+    for(const auto & o : run.overrides)
+    {
+      if(!config.Has(o.first))
+      {
+        std::cerr << "ERROR: " << manifest << ":" << line << ": unknown setting " << o.first << std::endl;
+        good = false;
+      }
+      if(o.first == "OUTPUT_DIR") {dir = o.second;}
+    }
+
+    // runs sharing a directory would overwrite each other's data
+    if(std::find(dirs.begin(), dirs.end(), dir) != dirs.end())
+    {
+      std::cerr << "ERROR: " << manifest << ":" << line << ": OUTPUT_DIR " << dir << " is used by an earlier run" << std::endl;
+      good = false;
+    }
+    dirs.push_back(dir);
+
+    runs.push_back(run);
+  }
+
+  if(!good) {runs.clear();}
+
+  return good;
+}
+
+void Batch::Run(const size_t jobs)
+{
+  std::cerr << "Running " << runs.size() << " batch runs on " << jobs << " threads" << std::endl;
+
+  TaskPool pool(jobs);
+  for(const auto & run : runs) {pool.Submit([this, &run]() {RunOne(run);});}
+  pool.Run();
+
+  std::cerr << "Finished " << runs.size() << " batch runs" << std::endl;
+}
+
+void Batch::RunOne(const run_t & run)
+{
+  // after a SIGINT/SIGTERM the runs in flight wind down and the rest never start
+  if(Termination::Signaled())
+  {
+    std::cerr << "Batch run on manifest line " << run.line << " skipped (signal)" << std::endl;
+    return;
+  }
+
+  // copy every setting, then apply this run's overrides
+  DiaConfig cfg;
+  for(const auto & entry : config) {cfg.Set(entry.first, entry.second->GetValue());}
+  for(const auto & o : run.overrides) {cfg.Set(o.first, o.second);}
+
+  MakeOutputDir(cfg.OUTPUT_DIR());
+
+  // progress lines of every run go to its own run.log (like the job scripts redirect them)
+  std::ofstream log(cfg.OUTPUT_DIR() + "run.log");
+  cfg.Write(log);
+
+  if(1 < cfg.ISLANDS())
+  {
+    IslandModel model(cfg);
+    model.Run();
+  }
+  else
+  {
+    DiagWorld world(cfg);
+    world.SetLog(log);
+
+    for(size_t ud = 0; ud <= cfg.MAX_GENS() && !world.Stopped(); ud++) {world.Update();}
+  }
+
+  std::cerr << "Batch run on manifest line " << run.line << " done (" << cfg.OUTPUT_DIR() << ")" << std::endl;
+}
+
+#endif
@@ -0,0 +1,385 @@
+/// Binary checkpoint of a DiagWorld taken between two generations, so a stopped run can carry on bit-for-bit
+/// Files are written under a temporary name and renamed into place, so a crash never leaves half a checkpoint behind
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+///< standard headers
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+///< empirical headers
+#include "base/vector.h"
+#include "tools/Random.h"
+
+///< experiment headers
+#include "config.h"
+#include "org.h"
+
+// the generator is saved as raw bytes
+static_assert(std::is_trivially_copyable<emp::Random>::value, "emp::Random must be trivially copyable to checkpoint it");
+
+/// Everything a run needs to continue from the start of a generation
+/// Values are stored in native byte order, so checkpoints only move between machines of the same kind
+struct Checkpoint
+{
+  // read only handles to org storage (copy-on-write keeps them unchanged while a checkpoint is written)
+  using genome_ptr_t = std::shared_ptr<const Org::genome_t>;
+  using score_ptr_t = std::shared_ptr<const Org::score_t>;
+  using optimal_ptr_t = std::shared_ptr<const Org::optimal_t>;
+
+  // generation the run carries on from
+  uint64_t update = 0;
+  // settings a resumed run has to share with the checkpointed one
+  int64_t seed = 0;
+  uint64_t pop_size = 0;
+  uint64_t objective_cnt = 0;
+  // experiment they belong to (selection scheme, diagnostic and mutation operator)
+  uint64_t selection = 0;
+  uint64_t diagnostic = 0;
+  double mutate_per = 0.0;
+  double mutate_mean = 0.0;
+  double mutate_std = 0.0;
+  uint8_t mutate_skip = 0;
+  uint8_t rng_streams = 0;
+  // bytes of data.csv and data.col written before that generation
+  uint64_t data_bytes = 0;
+  uint64_t col_bytes = 0;
+  // solutions and objective evaluations so far
+  uint64_t evals = 0;
+  uint64_t obj_evals = 0;
+  // stagnation state of the termination criteria (best value and the generation it was reached)
+  double stag_best = 0.0;
+  uint64_t stag_since = 0;
+  // event sampling state (best optimized count and pop_uni_obj of the last generation, if one was watched)
+  uint8_t sample_seen = 0;
+  uint64_t sample_opt = 0;
+  uint64_t sample_uni = 0;
+  // main random number generator
+  std::array<char, sizeof(emp::Random)> random;
+
+  // by position id (phenotype fields are only filled for clones, everyone else is evaluated again)
+  emp::vector<uint8_t> clone;
+  emp::vector<genome_ptr_t> genome;
+  emp::vector<score_ptr_t> score;
+  emp::vector<optimal_ptr_t> optimal;
+  emp::vector<uint64_t> count;
+  emp::vector<double> agg;
+  emp::vector<uint64_t> start;
+
+  // lineage table (Lineage::Save, empty without PHYLO)
+  std::string lineage;
+
+  ///< helper functions
+
+  // copy the generator state in and out
+  void SaveRandom(const emp::Random & rng) {std::memcpy(random.data(), &rng, sizeof(emp::Random));}
+  void LoadRandom(emp::Random & rng) const {std::memcpy(&rng, random.data(), sizeof(emp::Random));}
+
+  // add the org at the next position id
+  void AddOrg(Org & org);
+
+  // rebuild the org at position id i
+  Org MakeOrg(const size_t i) const;
+
+  /**
+   * Write function:
+   *
+   * Writes the checkpoint to path + ".tmp", then renames it over path.
+   * Safe to call from a background thread, as it only reads the checkpoint.
+   *
+   * @param path Where the checkpoint goes.
+   *
+   * @return True if the checkpoint made it to disk.
+   */
+  bool Write(const std::string & path) const;
+
+  // read a checkpoint made by Write, false if the file is missing or damaged
+  bool Read(const std::string & path);
+
+  // can a run with these settings (and its data.csv) carry on from this checkpoint?
+  bool Check(const DiaConfig & config, std::string & err) const;
+
+  // marks both ends of a checkpoint file
+  static constexpr char MAGIC[8] = {'D','I','A','C','K','P','T','7'};
+};
+
+void Checkpoint::AddOrg(Org & org)
+{
+  clone.push_back(org.GetClone());
+  genome.push_back(org.ShareGenome());
+
+  if(org.GetClone())
+  {
+    score.push_back(org.ShareScore());
+    optimal.push_back(org.ShareOptimal());
+    count.push_back(org.GetCount());
+    agg.push_back(org.GetAggregate());
+    start.push_back(org.GetStart());
+  }
+  else
+  {
+    score.push_back(nullptr); optimal.push_back(nullptr);
+    count.push_back(0); agg.push_back(0.0); start.push_back(0);
+  }
+}
+
+Org Checkpoint::MakeOrg(const size_t i) const
+{
+  // quick checks
+  emp_assert(i < genome.size()); emp_assert(genome[i]);
+
+  Org org(*genome[i]);
+  if(!clone[i]) {return org;}
+
+  emp_assert(score[i]); emp_assert(optimal[i]);
+  org.MeClone();
+  org.Inherit(*score[i], *optimal[i], count[i], agg[i], start[i]);
+
+  return org;
+}
+
+namespace ckpt
+{
+  template <typename T>
+  void Put(std::ostream & os, const T & val) {os.write(reinterpret_cast<const char *>(&val), sizeof(T));}
+
+  template <typename T>
+  bool Get(std::istream & is, T & val) {return static_cast<bool>(is.read(reinterpret_cast<char *>(&val), sizeof(T)));}
+
+  void PutDoubles(std::ostream & os, const emp::vector<double> & vec)
+  {
+    os.write(reinterpret_cast<const char *>(vec.data()), vec.size() * sizeof(double));
+  }
+
+  bool GetDoubles(std::istream & is, emp::vector<double> & vec, const size_t n)
+  {
+    vec.resize(n);
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(vec.data()), n * sizeof(double)));
+  }
+}
+
+bool Checkpoint::Write(const std::string & path) const
+{
+  const std::string tmp = path + ".tmp";
+  {
+    std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+    if(!os)
+    {
+      std::cerr << "ERROR: COULD NOT OPEN CHECKPOINT " << tmp << std::endl;
+      return false;
+    }
+
+    os.write(MAGIC, sizeof(MAGIC));
+    ckpt::Put(os, update); ckpt::Put(os, seed);
+    ckpt::Put(os, pop_size); ckpt::Put(os, objective_cnt);
+    ckpt::Put(os, selection); ckpt::Put(os, diagnostic);
+    ckpt::Put(os, mutate_per); ckpt::Put(os, mutate_mean); ckpt::Put(os, mutate_std);
+    ckpt::Put(os, mutate_skip); ckpt::Put(os, rng_streams);
+    ckpt::Put(os, data_bytes); ckpt::Put(os, col_bytes); ckpt::Put(os, evals); ckpt::Put(os, obj_evals);
+    ckpt::Put(os, stag_best); ckpt::Put(os, stag_since);
+    ckpt::Put(os, sample_seen); ckpt::Put(os, sample_opt); ckpt::Put(os, sample_uni);
+    os.write(random.data(), random.size());
+
+    for(size_t i = 0; i < genome.size(); ++i)
+    {
+      ckpt::Put(os, clone[i]);
+      ckpt::PutDoubles(os, *genome[i]);
+      if(!clone[i]) {continue;}
+
+      ckpt::PutDoubles(os, *score[i]);
+      for(const bool o : *optimal[i]) {ckpt::Put(os, static_cast<uint8_t>(o));}
+      ckpt::Put(os, count[i]); ckpt::Put(os, agg[i]); ckpt::Put(os, start[i]);
+    }
+
+    ckpt::Put(os, static_cast<uint64_t>(lineage.size()));
+    os.write(lineage.data(), lineage.size());
+
+    os.write(MAGIC, sizeof(MAGIC));
+    os.flush();
+    if(!os)
+    {
+      std::cerr << "ERROR: COULD NOT WRITE CHECKPOINT " << tmp << std::endl;
+      return false;
+    }
+  }
+
+  // the old checkpoint stays in place until the new one is complete
+  std::error_code err;
+  std::filesystem::rename(tmp, path, err);
+  if(err)
+  {
+    std::cerr << "ERROR: COULD NOT MOVE CHECKPOINT INTO " << path << ": " << err.message() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool Checkpoint::Read(const std::string & path)
+{
+  std::ifstream is(path, std::ios::binary);
+  if(!is)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN CHECKPOINT " << path << std::endl;
+    return false;
+  }
+
+  char magic[sizeof(MAGIC)];
+  bool good = is.read(magic, sizeof(magic)) && !std::memcmp(magic, MAGIC, sizeof(MAGIC));
+  good = good && ckpt::Get(is, update) && ckpt::Get(is, seed);
+  good = good && ckpt::Get(is, pop_size) && ckpt::Get(is, objective_cnt);
+  good = good && ckpt::Get(is, selection) && ckpt::Get(is, diagnostic);
+  good = good && ckpt::Get(is, mutate_per) && ckpt::Get(is, mutate_mean) && ckpt::Get(is, mutate_std);
+  good = good && ckpt::Get(is, mutate_skip) && ckpt::Get(is, rng_streams);
+  good = good && ckpt::Get(is, data_bytes) && ckpt::Get(is, col_bytes) && ckpt::Get(is, evals) && ckpt::Get(is, obj_evals);
+  good = good && ckpt::Get(is, stag_best) && ckpt::Get(is, stag_since);
+  good = good && ckpt::Get(is, sample_seen) && ckpt::Get(is, sample_opt) && ckpt::Get(is, sample_uni);
+  good = good && is.read(random.data(), random.size());
+
+  clone.clear(); genome.clear(); score.clear(); optimal.clear();
+  count.clear(); agg.clear(); start.clear();
+
+  for(size_t i = 0; good && i < pop_size; ++i)
+  {
+    uint8_t c = 0; emp::vector<double> g;
+    good = ckpt::Get(is, c) && ckpt::GetDoubles(is, g, objective_cnt);
+    clone.push_back(c);
+    genome.push_back(std::make_shared<const Org::genome_t>(g.begin(), g.end()));
+
+    if(!c)
+    {
+      score.push_back(nullptr); optimal.push_back(nullptr);
+      count.push_back(0); agg.push_back(0.0); start.push_back(0);
+      continue;
+    }
+
+    emp::vector<double> s; Org::optimal_t o(objective_cnt);
+    good = good && ckpt::GetDoubles(is, s, objective_cnt);
+    for(size_t j = 0; good && j < objective_cnt; ++j)
+    {
+      uint8_t b = 0;
+      good = ckpt::Get(is, b);
+      o[j] = b;
+    }
+
+    uint64_t cnt = 0, st = 0; double a = 0.0;
+    good = good && ckpt::Get(is, cnt) && ckpt::Get(is, a) && ckpt::Get(is, st);
+
+    score.push_back(std::make_shared<const Org::score_t>(s.begin(), s.end()));
+    optimal.push_back(std::make_shared<const Org::optimal_t>(o));
+    count.push_back(cnt); agg.push_back(a); start.push_back(st);
+  }
+
+  uint64_t lineage_size = 0;
+  good = good && ckpt::Get(is, lineage_size);
+  lineage.assign(good ? lineage_size : 0, '\0');
+  good = good && is.read(lineage.data(), lineage.size());
+
+  good = good && is.read(magic, sizeof(magic)) && !std::memcmp(magic, MAGIC, sizeof(MAGIC));
+  if(!good)
+  {
+    std::cerr << "ERROR: CHECKPOINT " << path << " IS DAMAGED" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool Checkpoint::Check(const DiaConfig & config, std::string & err) const
+{
+  // SEED 0 draws a seed from the clock, so only a fixed seed has to match
+  if(0 < config.SEED() && static_cast<int64_t>(config.SEED()) != seed)
+  {
+    err = "SEED " + std::to_string(config.SEED()) + " does not match the checkpoint's " + std::to_string(seed);
+    return false;
+  }
+  if(config.POP_SIZE() != pop_size)
+  {
+    err = "POP_SIZE " + std::to_string(config.POP_SIZE()) + " does not match the checkpoint's " + std::to_string(pop_size);
+    return false;
+  }
+  if(config.OBJECTIVE_CNT() != objective_cnt)
+  {
+    err = "OBJECTIVE_CNT " + std::to_string(config.OBJECTIVE_CNT()) + " does not match the checkpoint's " + std::to_string(objective_cnt);
+    return false;
+  }
+  if(config.MAX_GENS() < update)
+  {
+    err = "the checkpoint is already past MAX_GENS";
+    return false;
+  }
+
+  // a different experiment would carry on from a population it did not evolve
+  if(config.SELECTION() != selection)
+  {
+    err = "SELECTION " + std::to_string(config.SELECTION()) + " does not match the checkpoint's " + std::to_string(selection);
+    return false;
+  }
+  if(config.DIAGNOSTIC() != diagnostic)
+  {
+    err = "DIAGNOSTIC " + std::to_string(config.DIAGNOSTIC()) + " does not match the checkpoint's " + std::to_string(diagnostic);
+    return false;
+  }
+  if(config.MUTATE_PER() != mutate_per || config.MEAN() != mutate_mean || config.STD() != mutate_std)
+  {
+    err = "MUTATE_PER, MEAN or STD do not match the checkpoint's " + std::to_string(mutate_per) + ", " + std::to_string(mutate_mean) + ", " + std::to_string(mutate_std);
+    return false;
+  }
+  if(config.MUTATE_SKIP() != static_cast<bool>(mutate_skip))
+  {
+    err = "MUTATE_SKIP " + std::to_string(config.MUTATE_SKIP()) + " does not match the checkpoint's " + std::to_string(mutate_skip);
+    return false;
+  }
+  // streams and the shared generator draw different numbers, so the run would not carry on bit-for-bit
+  if(config.RNG_STREAMS() != static_cast<bool>(rng_streams))
+  {
+    err = "RNG_STREAMS " + std::to_string(config.RNG_STREAMS()) + " does not match the checkpoint's " + std::to_string(rng_streams);
+    return false;
+  }
+
+  if(config.PHYLO() && lineage.empty())
+  {
+    err = "the checkpoint was taken without lineage tracking (PHYLO 0)";
+    return false;
+  }
+
+  // rows written after the checkpoint are dropped, but every row before it has to be there
+  std::error_code fs_err;
+  const std::string data_path = config.OUTPUT_DIR() + "data.csv";
+  if(config.DATA_FORMAT() != 1)
+  {
+    const auto size = std::filesystem::file_size(data_path, fs_err);
+    if(fs_err || size < data_bytes)
+    {
+      err = data_path + " is missing rows written before the checkpoint";
+      return false;
+    }
+  }
+
+  const std::string col_path = config.OUTPUT_DIR() + "data.col";
+  if(0 < config.DATA_FORMAT())
+  {
+    const auto size = std::filesystem::file_size(col_path, fs_err);
+    if(col_bytes == 0)
+    {
+      err = "the checkpoint was taken without data.col (DATA_FORMAT 0)";
+      return false;
+    }
+    if(fs_err || size < col_bytes)
+    {
+      err = col_path + " is missing blocks written before the checkpoint";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+#endif
@@ -0,0 +1,652 @@
+/// Binary columnar time series (data.col): typed fixed-width columns written in compressed blocks
+/// The schema sits at the front, an index of every block sits in a footer at the back
+///
+/// Layout (native byte order, like checkpoints):
+///   header  "DIACOL01", column count (u32), per column: type (u8), key and description (u16 length + bytes)
+///   blocks  "CBLK", rows (u32), codec (u8) + 3 pad bytes, raw size (u64), stored size (u64), payload
+///   footer  per block: offset (u64), first row (u64), rows (u64); then index offset, block count, row count (u64) and "DIACOLIX"
+/// A block payload holds each column in turn, rows x 8 bytes: integers as zigzag deltas, doubles XORed with the previous row.
+/// Files without a footer (a run that crashed) can still be read by walking the blocks.
+/// ColumnReader maps the file, so reading a column only touches the blocks (and, for raw blocks, the bytes) it needs.
+
+#ifndef COLUMNS_H
+#define COLUMNS_H
+
+///< standard headers
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+///< system headers
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DIA_COL_MMAP
+#endif
+
+///< empirical headers
+#include "base/vector.h"
+
+///< compression (build with -DDIA_ZSTD and link -lzstd), raw blocks otherwise
+#ifdef DIA_ZSTD
+#include <zstd.h>
+#endif
+
+namespace col
+{
+  // column value types
+  enum Type : uint8_t {U64 = 0, F64 = 1};
+  // block codecs
+  enum Codec : uint8_t {RAW = 0, ZSTD = 1};
+
+  // magic numbers for the header, every block and the footer
+  constexpr char HEAD[8] = {'D','I','A','C','O','L','0','1'};
+  constexpr char BLOCK[4] = {'C','B','L','K'};
+  constexpr char FOOT[8] = {'D','I','A','C','O','L','I','X'};
+
+  // size of a block header and the fixed footer tail
+  constexpr size_t BLOCK_HEAD = 4 + 4 + 4 + 8 + 8;
+  constexpr size_t FOOT_TAIL = 8 * 3 + sizeof(FOOT);
+
+  // one entry of the footer index
+  struct Entry
+  {
+    uint64_t offset = 0;
+    uint64_t first = 0;
+    uint64_t rows = 0;
+  };
+
+  ///< value encoding
+
+  inline uint64_t Zigzag(const uint64_t cur, const uint64_t prev)
+  {
+    const int64_t d = static_cast<int64_t>(cur - prev);
+    return (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+  }
+
+  inline uint64_t Unzigzag(const uint64_t z, const uint64_t prev)
+  {
+    const uint64_t d = (z >> 1) ^ (~(z & 1) + 1);
+    return prev + d;
+  }
+
+  inline uint64_t Bits(const double v) {uint64_t b; std::memcpy(&b, &v, sizeof(b)); return b;}
+  inline double Double(const uint64_t b) {double v; std::memcpy(&v, &b, sizeof(v)); return v;}
+
+  template <typename T>
+  void Put(std::string & buf, const T & val) {buf.append(reinterpret_cast<const char *>(&val), sizeof(T));}
+
+  template <typename T>
+  T Get(const char * ptr) {T val; std::memcpy(&val, ptr, sizeof(T)); return val;}
+
+  /**
+   * Encode function:
+   *
+   * Turns a block of rows (row major, one u64 per value) into its payload (column major).
+   *
+   * @param rows Row values as raw bits.
+   * @param types Column types.
+   * @param n Rows in the block.
+   *
+   * @return Payload before compression.
+   */
+  std::string Encode(const emp::vector<uint64_t> & rows, const emp::vector<Type> & types, const size_t n)
+  {
+    const size_t cols = types.size();
+    std::string out; out.reserve(n * cols * 8);
+
+    for(size_t c = 0; c < cols; ++c)
+    {
+      uint64_t prev = 0;
+      for(size_t r = 0; r < n; ++r)
+      {
+        const uint64_t cur = rows[r * cols + c];
+        Put<uint64_t>(out, (types[c] == U64) ? Zigzag(cur, prev) : (cur ^ prev));
+        prev = cur;
+      }
+    }
+
+    return out;
+  }
+
+  // undo Encode, rows come back row major
+  void Decode(const char * payload, const emp::vector<Type> & types, const size_t n, emp::vector<uint64_t> & rows)
+  {
+    const size_t cols = types.size();
+    rows.resize(n * cols);
+
+    for(size_t c = 0; c < cols; ++c)
+    {
+      uint64_t prev = 0;
+      for(size_t r = 0; r < n; ++r)
+      {
+        const uint64_t v = Get<uint64_t>(payload + (c * n + r) * 8);
+        prev = (types[c] == U64) ? Unzigzag(v, prev) : (v ^ prev);
+        rows[r * cols + c] = prev;
+      }
+    }
+  }
+
+  // undo Encode for column c only, values come back in row order
+  void DecodeColumn(const char * payload, const Type type, const size_t n, const size_t c, emp::vector<uint64_t> & vals)
+  {
+    vals.resize(n);
+
+    uint64_t prev = 0;
+    for(size_t r = 0; r < n; ++r)
+    {
+      const uint64_t v = Get<uint64_t>(payload + (c * n + r) * 8);
+      prev = (type == U64) ? Unzigzag(v, prev) : (v ^ prev);
+      vals[r] = prev;
+    }
+  }
+}
+
+class ColumnWriter
+{
+  // object types we are using in this class
+  public:
+    // pulls the value of a column for the current row
+    using fun_t = std::function<uint64_t()>;
+
+
+  public:
+
+    ColumnWriter(const size_t _block_rows = 1024) : block_rows(_block_rows) {emp_assert(0 < block_rows);}
+
+    ~ColumnWriter() {Close();}
+
+    ///< setup (before Open)
+
+    /**
+     * Add function:
+     *
+     * Registers a column, in the same order and under the same key as its data.csv twin.
+     *
+     * @param fun Returns the column's value for the current row (size_t or double).
+     * @param key Column name.
+     * @param desc Column description.
+     */
+    template <typename T>
+    void Add(std::function<T()> fun, const std::string & key, const std::string & desc);
+
+    // column names in order
+    const emp::vector<std::string> & GetKeys() const {return keys;}
+
+    ///< writing
+
+    /**
+     * Open function:
+     *
+     * Starts the file, or carries on with one made by the same columns (resuming a run).
+     *
+     * @param path Where the file goes.
+     * @param keep Bytes of an existing file to keep (0 starts a new file), everything after is dropped.
+     *
+     * @return True if the file is ready for rows.
+     */
+    bool Open(const std::string & path, const uint64_t keep = 0);
+
+    // pull one row from every column
+    void Update();
+
+    // write the rows waiting in memory as a block
+    bool Flush();
+
+    // flush and write the footer index (nothing can be added after)
+    // without the index, the file reads like an unfinished run (a run stopped by a signal carries on later)
+    void Close(const bool finished = true);
+
+    // bytes on disk (rows still waiting in memory are not counted, Flush first)
+    uint64_t GetBytes() const {return bytes;}
+
+    // rows written so far (waiting ones included)
+    uint64_t GetRows() const {return rows_done + pending;}
+
+  private:
+    // serialized schema header
+    std::string Header() const;
+
+    // rows per block
+    size_t block_rows;
+
+    // columns
+    emp::vector<col::Type> types;
+    emp::vector<std::string> keys;
+    emp::vector<std::string> descs;
+    emp::vector<fun_t> funs;
+
+    // output file and its size
+    std::ofstream os;
+    uint64_t bytes = 0;
+    // rows waiting for the next block (row major raw bits)
+    emp::vector<uint64_t> buffer;
+    size_t pending = 0;
+    // rows already in blocks
+    uint64_t rows_done = 0;
+    // footer index
+    emp::vector<col::Entry> index;
+};
+
+template <typename T>
+void ColumnWriter::Add(std::function<T()> fun, const std::string & key, const std::string & desc)
+{
+  static_assert(std::is_same<T, size_t>::value || std::is_same<T, double>::value, "columns hold size_t or double values");
+  emp_assert(!os.is_open());
+
+  if constexpr (std::is_same<T, double>::value)
+  {
+    types.push_back(col::F64);
+    funs.push_back([fun]() {return col::Bits(fun());});
+  }
+  else
+  {
+    types.push_back(col::U64);
+    funs.push_back([fun]() {return static_cast<uint64_t>(fun());});
+  }
+  keys.push_back(key);
+  descs.push_back(desc);
+}
+
+std::string ColumnWriter::Header() const
+{
+  std::string head(col::HEAD, sizeof(col::HEAD));
+  col::Put<uint32_t>(head, types.size());
+  for(size_t c = 0; c < types.size(); ++c)
+  {
+    col::Put<uint8_t>(head, types[c]);
+    col::Put<uint16_t>(head, keys[c].size()); head += keys[c];
+    col::Put<uint16_t>(head, descs[c].size()); head += descs[c];
+  }
+
+  return head;
+}
+
+bool ColumnWriter::Open(const std::string & path, const uint64_t keep)
+{
+  // quick checks
+  emp_assert(!os.is_open()); emp_assert(0 < types.size());
+
+  const std::string head = Header();
+  index.clear(); rows_done = 0; pending = 0;
+  buffer.resize(block_rows * types.size());
+
+  if(keep == 0)
+  {
+    os.open(path, std::ios::binary | std::ios::trunc);
+    os.write(head.data(), head.size());
+    bytes = head.size();
+    return static_cast<bool>(os);
+  }
+
+  // read back what we keep: the schema has to match, and the blocks rebuild the index
+  std::string kept;
+  {
+    std::ifstream is(path, std::ios::binary);
+    kept.resize(keep);
+    if(!is || !is.read(kept.data(), keep))
+    {
+      std::cerr << "ERROR: " << path << " IS SHORTER THAN " << keep << " BYTES" << std::endl;
+      return false;
+    }
+  }
+  if(kept.compare(0, head.size(), head) != 0)
+  {
+    std::cerr << "ERROR: COLUMNS IN " << path << " DO NOT MATCH THIS RUN" << std::endl;
+    return false;
+  }
+
+  uint64_t at = head.size();
+  while(at + col::BLOCK_HEAD <= keep && !std::memcmp(kept.data() + at, col::BLOCK, sizeof(col::BLOCK)))
+  {
+    const uint32_t rows = col::Get<uint32_t>(kept.data() + at + 4);
+    const uint64_t stored = col::Get<uint64_t>(kept.data() + at + 20);
+    if(keep < at + col::BLOCK_HEAD + stored) {break;}
+
+    index.push_back({at, rows_done, rows});
+    rows_done += rows;
+    at += col::BLOCK_HEAD + stored;
+  }
+  if(at != keep)
+  {
+    std::cerr << "ERROR: " << path << " DOES NOT END ON A BLOCK AT " << keep << " BYTES" << std::endl;
+    return false;
+  }
+
+  std::error_code err;
+  std::filesystem::resize_file(path, keep, err);
+  if(err)
+  {
+    std::cerr << "ERROR: COULD NOT TRIM " << path << ": " << err.message() << std::endl;
+    return false;
+  }
+
+  os.open(path, std::ios::binary | std::ios::app);
+  bytes = keep;
+  return static_cast<bool>(os);
+}
+
+void ColumnWriter::Update()
+{
+  // quick checks
+  emp_assert(os.is_open()); emp_assert(pending < block_rows);
+
+  uint64_t * row = buffer.data() + pending * funs.size();
+  for(size_t c = 0; c < funs.size(); ++c) {row[c] = funs[c]();}
+
+  if(++pending == block_rows) {Flush();}
+}
+
+bool ColumnWriter::Flush()
+{
+  if(!os.is_open()) {return false;}
+  if(pending == 0) {return true;}
+
+  const std::string raw = col::Encode(buffer, types, pending);
+  std::string stored = raw;
+  uint8_t codec = col::RAW;
+
+#ifdef DIA_ZSTD
+  std::string packed(ZSTD_compressBound(raw.size()), '\0');
+  const size_t len = ZSTD_compress(packed.data(), packed.size(), raw.data(), raw.size(), 3);
+  if(!ZSTD_isError(len) && len < raw.size())
+  {
+    packed.resize(len);
+    stored = std::move(packed);
+    codec = col::ZSTD;
+  }
+#endif
+
+  std::string head(col::BLOCK, sizeof(col::BLOCK));
+  col::Put<uint32_t>(head, pending);
+  col::Put<uint8_t>(head, codec); head.append(3, '\0');
+  col::Put<uint64_t>(head, raw.size());
+  col::Put<uint64_t>(head, stored.size());
+
+  os.write(head.data(), head.size());
+  os.write(stored.data(), stored.size());
+  os.flush();
+
+  index.push_back({bytes, rows_done, pending});
+  bytes += head.size() + stored.size();
+  rows_done += pending;
+  pending = 0;
+
+  return static_cast<bool>(os);
+}
+
+void ColumnWriter::Close(const bool finished)
+{
+  if(!os.is_open()) {return;}
+  Flush();
+  if(!finished) {os.close(); return;}
+
+  std::string foot;
+  for(const auto & e : index) {col::Put(foot, e.offset); col::Put(foot, e.first); col::Put(foot, e.rows);}
+  col::Put<uint64_t>(foot, bytes);
+  col::Put<uint64_t>(foot, index.size());
+  col::Put<uint64_t>(foot, rows_done);
+  foot.append(col::FOOT, sizeof(col::FOOT));
+
+  os.write(foot.data(), foot.size());
+  os.close();
+}
+
+class ColumnReader
+{
+  public:
+
+    ColumnReader() {;}
+    ColumnReader(const ColumnReader &) = delete;
+    ColumnReader & operator=(const ColumnReader &) = delete;
+    ~ColumnReader() {Close();}
+
+    /**
+     * Open function:
+     *
+     * Maps a data.col file and reads its schema, and every block from the footer index (or by walking the blocks).
+     * Block payloads are only read when a block or column is asked for.
+     *
+     * @param path File to read.
+     *
+     * @return True if the file could be read.
+     */
+    bool Open(const std::string & path);
+
+    // unmap the file
+    void Close();
+
+    // columns
+    size_t GetColumnCnt() const {return keys.size();}
+    const emp::vector<std::string> & GetKeys() const {return keys;}
+    const emp::vector<std::string> & GetDescs() const {return descs;}
+    const emp::vector<col::Type> & GetTypes() const {return types;}
+
+    // blocks and rows
+    size_t GetBlockCnt() const {return index.size();}
+    uint64_t GetRowCnt() const {return rows;}
+    // did the file end with a footer index (false for a run that did not finish)?
+    bool GetIndexed() const {return indexed;}
+
+    // read block b, rows come back row major as raw bits (col::Double turns F64 bits back)
+    bool ReadBlock(const size_t b, emp::vector<uint64_t> & out);
+
+    // read column c of block b only, in row order (raw blocks decode it in place, compressed ones are unpacked first)
+    bool ReadColumn(const size_t b, const size_t c, emp::vector<uint64_t> & out);
+
+    // write everything out as data.csv would look
+    bool WriteCSV(std::ostream & os);
+
+  private:
+    // uncompressed payload of block b (points into the file for raw blocks, into unpacked otherwise), nullptr if unreadable
+    const char * Payload(const size_t b, std::string & unpacked);
+
+  private:
+    // whole file, and its size
+    const char * base = nullptr;
+    size_t length = 0;
+    // the file when it could not be mapped
+    emp::vector<uint64_t> copy;
+    // columns
+    emp::vector<col::Type> types;
+    emp::vector<std::string> keys;
+    emp::vector<std::string> descs;
+    // blocks
+    emp::vector<col::Entry> index;
+    uint64_t rows = 0;
+    bool indexed = false;
+};
+
+bool ColumnReader::Open(const std::string & path)
+{
+  Close();
+
+#ifdef DIA_COL_MMAP
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  struct stat st;
+  if(fd < 0 || ::fstat(fd, &st) != 0)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;
+    if(0 <= fd) {::close(fd);}
+    return false;
+  }
+
+  length = static_cast<size_t>(st.st_size);
+  void * map = length ? ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if(map == MAP_FAILED)
+  {
+    std::cerr << "ERROR: COULD NOT MAP " << path << std::endl;
+    length = 0;
+    return false;
+  }
+  base = static_cast<const char *>(map);
+#else
+  // no mmap here, so the file is read into memory (kept 8 byte aligned)
+  std::ifstream is(path, std::ios::binary | std::ios::ate);
+  if(!is)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;
+    return false;
+  }
+  length = static_cast<size_t>(is.tellg());
+  copy.resize((length + 7) / 8);
+  is.seekg(0);
+  is.read(reinterpret_cast<char *>(copy.data()), length);
+  base = reinterpret_cast<const char *>(copy.data());
+#endif
+
+  // schema
+  size_t at = sizeof(col::HEAD) + 4;
+  if(length < at || std::memcmp(base, col::HEAD, sizeof(col::HEAD)))
+  {
+    std::cerr << "ERROR: " << path << " IS NOT A DATA.COL FILE" << std::endl;
+    Close();
+    return false;
+  }
+  const uint32_t cols = col::Get<uint32_t>(base + sizeof(col::HEAD));
+  for(uint32_t c = 0; c < cols; ++c)
+  {
+    if(length < at + 3) {Close(); return false;}
+    types.push_back(static_cast<col::Type>(base[at])); at += 1;
+
+    for(auto * out : {&keys, &descs})
+    {
+      const uint16_t len = col::Get<uint16_t>(base + at); at += 2;
+      if(length < at + len) {Close(); return false;}
+      out->emplace_back(base + at, len); at += len;
+    }
+  }
+
+  // footer index
+  if(col::FOOT_TAIL <= length && !std::memcmp(base + length - sizeof(col::FOOT), col::FOOT, sizeof(col::FOOT)))
+  {
+    const char * tail = base + length - col::FOOT_TAIL;
+    const uint64_t off = col::Get<uint64_t>(tail);
+    const uint64_t cnt = col::Get<uint64_t>(tail + 8);
+    rows = col::Get<uint64_t>(tail + 16);
+
+    if(off + cnt * sizeof(col::Entry) + col::FOOT_TAIL == length)
+    {
+      index.resize(cnt);
+      std::memcpy(index.data(), base + off, cnt * sizeof(col::Entry));
+      indexed = true;
+      return true;
+    }
+    rows = 0;
+  }
+
+  // no footer, walk the blocks
+  while(at + col::BLOCK_HEAD <= length && !std::memcmp(base + at, col::BLOCK, sizeof(col::BLOCK)))
+  {
+    const uint32_t n = col::Get<uint32_t>(base + at + 4);
+    const uint64_t stored = col::Get<uint64_t>(base + at + 20);
+    if(length < at + col::BLOCK_HEAD + stored) {break;}
+
+    index.push_back({at, rows, n});
+    rows += n;
+    at += col::BLOCK_HEAD + stored;
+  }
+
+  return true;
+}
+
+void ColumnReader::Close()
+{
+#ifdef DIA_COL_MMAP
+  if(base) {::munmap(const_cast<char *>(base), length);}
+#endif
+  copy.clear();
+  base = nullptr;
+  length = 0;
+  types.clear(); keys.clear(); descs.clear(); index.clear(); rows = 0; indexed = false;
+}
+
+bool ColumnReader::ReadBlock(const size_t b, emp::vector<uint64_t> & out)
+{
+  std::string unpacked;
+  const char * payload = Payload(b, unpacked);
+  if(!payload) {return false;}
+
+  col::Decode(payload, types, index[b].rows, out);
+  return true;
+}
+
+bool ColumnReader::ReadColumn(const size_t b, const size_t c, emp::vector<uint64_t> & out)
+{
+  // quick checks
+  emp_assert(c < types.size());
+
+  std::string unpacked;
+  const char * payload = Payload(b, unpacked);
+  if(!payload) {return false;}
+
+  col::DecodeColumn(payload, types[c], index[b].rows, c, out);
+  return true;
+}
+
+const char * ColumnReader::Payload(const size_t b, std::string & unpacked)
+{
+  // quick checks
+  emp_assert(b < index.size());
+
+  const char * block = base + index[b].offset;
+  const uint32_t n = col::Get<uint32_t>(block + 4);
+  const uint8_t codec = col::Get<uint8_t>(block + 8);
+  const uint64_t raw = col::Get<uint64_t>(block + 12);
+  const uint64_t stored = col::Get<uint64_t>(block + 20);
+  const char * payload = block + col::BLOCK_HEAD;
+
+  if(n != index[b].rows || raw != n * types.size() * 8) {return nullptr;}
+  if(codec == col::RAW && stored == raw) {return payload;}
+
+#ifdef DIA_ZSTD
+  if(codec == col::ZSTD)
+  {
+    unpacked.assign(raw, '\0');
+    const size_t len = ZSTD_decompress(unpacked.data(), raw, payload, stored);
+    if(ZSTD_isError(len) || len != raw) {return nullptr;}
+    return unpacked.data();
+  }
+#endif
+
+  std::cerr << "ERROR: BLOCK " << b << " USES CODEC " << static_cast<int>(codec) << ", BUILD WITH -DDIA_ZSTD TO READ IT" << std::endl;
+  return nullptr;
+}
+
+bool ColumnReader::WriteCSV(std::ostream & os)
+{
+  // header keys, then every row (same formatting as emp::DataFile)
+  for(size_t c = 0; c < keys.size(); ++c) {if(c) {os << ",";} os << keys[c];}
+  os << "\n";
+
+  emp::vector<uint64_t> vals;
+  for(size_t b = 0; b < index.size(); ++b)
+  {
+    if(!ReadBlock(b, vals)) {return false;}
+
+    const size_t cols = types.size();
+    for(size_t r = 0; r < vals.size() / cols; ++r)
+    {
+      for(size_t c = 0; c < cols; ++c)
+      {
+        if(c) {os << ",";}
+        const uint64_t v = vals[r * cols + c];
+        if(types[c] == col::F64) {os << col::Double(v);}
+        else {os << static_cast<size_t>(v);}
+      }
+      os << "\n";
+    }
+  }
+
+  return static_cast<bool>(os);
+}
+
+#endif
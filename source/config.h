@@ -7,7 +7,24 @@ EMP_BUILD_CONFIG(DiaConfig,
   GROUP(WORLD, "How should the world be setup?"),
   VALUE(POP_SIZE,     size_t,      512,    "Population size."),
   VALUE(MAX_GENS,     size_t,    40001,    "Maximum number of generations."),
-  VALUE(SEED,           int,         0,    "Random number seed."),
+  VALUE(SEED,           int,         0,    "Random number seed (0 or less draws one, written to run_config.csv)."),
+  VALUE(RNG_STREAMS,    bool,    false,    "Give every stochastic operator its own counter-based stream keyed by (SEED, generation, phase, individual)?"),
+  VALUE(THREADS,        size_t,      1,    "Number of worker threads used to create offspring (more than 1 requires RNG_STREAMS)."),
+  VALUE(PIPELINE,       bool,    false,    "Record data on a background thread while the next generation runs?"),
+
+  GROUP(ISLAND_MODEL, "How are islands and migration setup?"),
+  VALUE(ISLANDS,            size_t,       1,     "Number of islands (each runs its own population of POP_SIZE on its own thread)."),
+  VALUE(MIGRATE_INTERVAL,   size_t,      10,     "How many generations between migrations? (0 means never)"),
+  VALUE(MIGRANT_CNT,        size_t,       1,     "Number of solutions each island sends at a migration."),
+  VALUE(MIGRATE_TOPOLOGY,   size_t,       0,     "Which islands trade migrants? \n0: Ring (fixed)\n1: Random ring (new every migration)"),
+  VALUE(MIGRATE_ELITE,      bool,      true,     "Send the best solutions (true) or a random sample (false)?"),
+
+  GROUP(TERMINATION, "When should a run stop before MAX_GENS?"),
+  VALUE(STOP_OPTIMIZED,      bool,        false,     "Stop once a solution optimizes every objective?"),
+  VALUE(STAG_GENS,           size_t,          0,     "Stop after this many generations without the stagnation metric improving (0 means never)."),
+  VALUE(STAG_METRIC,         size_t,          0,     "Which metric is checked for stagnation? \n0: ele_agg_per\n1: pop_uni_obj"),
+  VALUE(MAX_EVALS,           size_t,          0,     "Stop once this many objective evaluations (obj_evals) have been made (0 means never)."),
+  VALUE(MAX_SECONDS,         double,        0.0,     "Stop after this much wall clock time in seconds, counted from (re)start (0 means never)."),
 
   GROUP(DIAGNOSTICS, "How are the diagnostics setup?"),
   VALUE(TARGET,              double,     100.0,      "Target that traits are trying to optimize towards."),
@@ -21,6 +38,7 @@ EMP_BUILD_CONFIG(DiaConfig,
   VALUE(MUTATE_PER,       double,     0.007,        "Probability of instructions being mutated"),
   VALUE(MEAN,             double,     0.0,          "Mean of Gaussian Distribution for mutations"),
   VALUE(STD,              double,     1.0,          "Standard Deviation of Gaussian Distribution for mutations"),
+  VALUE(MUTATE_SKIP,      bool,       false,        "Skip straight to mutated genes with geometric gaps instead of a coin flip per gene?"),
 
   GROUP(PARAMETERS, "Parameter estimations all selection schemes."),
   VALUE(MU,               size_t,           512,       "Parameter estiamte for μ."),
@@ -34,9 +52,26 @@ EMP_BUILD_CONFIG(DiaConfig,
   VALUE(COH_LEX_PROP,     double,           1.0,       "Parameter for cohort proportions"),
 
   GROUP(SYSTEMATICS, "Output rates for OpenWorld"),
-  VALUE(SNAP_INTERVAL,             size_t,             1000,          "How many updates between prints?"),
+  VALUE(SNAP_INTERVAL,             size_t,             1000,          "How many updates between checkpoints (resume with --resume OUTPUT_DIR/checkpoint.bin)? (on by default, every run writes OUTPUT_DIR/checkpoint.bin, 0 means never)"),
   VALUE(DATA_INTERVAL,             size_t,                10,          "How many updates between writing data to file?"),
+  VALUE(DATA_SAMPLING,             size_t,                 0,          "Which generations get a data row? \n0: every DATA_INTERVAL\n1: log spaced, DATA_PER_DECADE per power of ten\n2: every DATA_INTERVAL up to DATA_DENSE_GENS, then every DATA_SPARSE_INTERVAL\n3: every DATA_SPARSE_INTERVAL and whenever the best optimized count or pop_uni_obj changes"),
+  VALUE(DATA_PER_DECADE,           size_t,                50,          "Rows per power of ten generations with log spaced sampling (DATA_SAMPLING 1)?"),
+  VALUE(DATA_DENSE_GENS,           size_t,             10000,          "Generations sampled every DATA_INTERVAL before going sparse (DATA_SAMPLING 2)?"),
+  VALUE(DATA_SPARSE_INTERVAL,      size_t,              1000,          "How many updates between rows once sampling is sparse (DATA_SAMPLING 2 and 3)?"),
+  VALUE(DATA_FORMAT,               size_t,                 0,          "Which data files are written? \n0: data.csv\n1: data.col (binary columnar, see col2csv)\n2: both"),
+  VALUE(WRITE_BUFFER,              size_t,                 0,          "Kilobytes of data.csv output buffered for a writer thread? (0 means write on the simulation thread)"),
   VALUE(PRINT_INTERVAL,            size_t,                 1,          "How many updates between prints?"),
+  VALUE(TIMING_INTERVAL,           size_t,                 0,          "How many updates between timing.csv rows of per-phase wall clock times? (0 means no timing)"),
+  VALUE(TRACE_FROM,                size_t,                 0,          "First generation written to trace.json?"),
+  VALUE(TRACE_GENS,                size_t,                 0,          "How many generations of phase, kernel and I/O spans are written to trace.json (Chrome trace events, open in Perfetto)? (0 means no tracing)"),
+  VALUE(COUNTERS,                  bool,               false,          "Count cycles, instructions, cache and branch misses per phase into counters.csv (Linux perf_event_open)?"),
+  VALUE(PHYLO,                     bool,               false,          "Track lineages (pruned to the living ones) into phylo.csv every DATA_INTERVAL and phylo_<gen>.csv snapshots every SNAP_INTERVAL updates?"),
+  VALUE(PHYLO_PHENOTYPE,           bool,               false,          "Keep the score vector of every taxon in the phylo_<gen>.csv snapshots?"),
+  VALUE(POP_SNAP,                  bool,               false,          "Write the whole population to pop_<gen>.snap every SNAP_INTERVAL updates (fixed binary layout, read with snapshot.h or snap2csv)?"),
+  VALUE(LOG_LEVEL,                 size_t,                 2,          "Which console messages are printed? \n0: errors\n1: + warnings\n2: + progress and setup\n3: + debug details"),
+  VALUE(LOG_SECONDS,               double,               0.0,          "Fewest seconds between progress lines? (0 means every PRINT_INTERVAL)"),
+  VALUE(LOG_BUFFER,                size_t,                64,          "Kilobytes of console output held before writing? (0 writes every line, held lines go out once they are a second old, checked every generation)"),
+  VALUE(LOG_JSON,                  bool,               false,          "Print console messages as JSON lines?"),
   VALUE(OUTPUT_DIR,           std::string,              "./",          "What directory are we dumping all this data")
 )
 
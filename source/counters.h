@@ -0,0 +1,253 @@
+/// Hardware performance counters (Linux perf_event_open): cycles, instructions, L1 data and last level cache misses
+/// and branch misses of the thread running the generations, added up per phase and written to counters.csv
+/// Counters the machine (or perf_event_paranoid) does not allow are left out, and without any the class does nothing
+
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+///< standard headers
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+
+///< system headers
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+///< empirical headers
+#include "base/vector.h"
+
+///< experiment headers
+#include "timing.h"
+
+class Counters
+{
+  // object types we are using in this class
+  public:
+    // counted events
+    enum Event : size_t {CYCLES = 0, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, EVENTS};
+    // one value per event
+    using values_t = std::array<uint64_t, EVENTS>;
+
+    /// Adds the counts between its construction and Stop (or its end) to a phase (does nothing without counters)
+    class Sample
+    {
+      public:
+        Sample() {;}
+        Sample(Counters * _counters, const size_t _phase) : counters(_counters), phase(_phase) {counters->Read(start);}
+        Sample(Sample && other) : counters(other.counters), phase(other.phase), start(other.start) {other.counters = nullptr;}
+        Sample(const Sample &) = delete;
+        ~Sample() {Stop();}
+
+        // count up to now instead of to the end of the scope
+        void Stop()
+        {
+          if(!counters) {return;}
+          values_t end;
+          counters->Read(end);
+          counters->Add(phase, start, end);
+          counters = nullptr;
+        }
+
+      private:
+        Counters * counters = nullptr;
+        size_t phase = 0;
+        values_t start{};
+    };
+
+
+  public:
+
+    Counters() : calls(Timing::PHASES, 0), totals(Timing::PHASES, values_t{}) {fds.fill(-1);}
+
+    ~Counters() {Close();}
+
+    ///< helper functions
+
+    // start counting the calling thread, false (with the reason in GetError) if no counter is available
+    // (only tried once, later calls return what the first one found)
+    bool Open();
+
+    // has Open been called?
+    bool Tried() const {return tried;}
+
+    // is at least one counter running?
+    bool Good() const {return 0 <= leader;}
+
+    // is this event counted?
+    bool Has(const size_t event) const {return 0 <= fds[event];}
+
+    // why counters are missing (empty if none are)
+    const std::string & GetError() const {return error;}
+
+    // sample of a phase
+    Sample Count(const size_t phase) {return Good() ? Sample(this, phase) : Sample();}
+
+    // totals of a phase
+    size_t GetCalls(const size_t phase) const {return calls[phase];}
+    const values_t & GetTotal(const size_t phase) const {return totals[phase];}
+
+    // one row per counted phase, tagged with the selection scheme and diagnostic of the run
+    void Write(const std::string & path, const size_t selection, const size_t diagnostic) const;
+
+    static const char * Name(const size_t event);
+
+  private:
+    // current values, scaled up when the kernel had to multiplex the counters
+    void Read(values_t & values) const;
+
+    // add end - start to a phase
+    void Add(const size_t phase, const values_t & start, const values_t & end);
+
+    void Close();
+
+  private:
+    // one descriptor per event (-1 if it is not counted) and the group leader
+    std::array<int, EVENTS> fds;
+    int leader = -1;
+    // position of each event in a group read
+    std::array<size_t, EVENTS> slot{};
+    size_t opened = 0;
+    bool tried = false;
+    std::string error;
+
+    emp::vector<size_t> calls;
+    emp::vector<values_t> totals;
+};
+
+bool Counters::Open()
+{
+  if(tried) {return Good();}
+  tried = true;
+
+#ifdef __linux__
+  // (type, config) of every event
+  const uint32_t cache = PERF_TYPE_HW_CACHE;
+  const uint64_t l1d = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  const std::array<std::pair<uint32_t, uint64_t>, EVENTS> events =
+  {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {cache, l1d},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+  }};
+
+  for(size_t e = 0; e < EVENTS; ++e)
+  {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = events[e].first;
+    attr.config = events[e].second;
+    // user space only, which perf_event_paranoid up to 2 allows without privileges
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.disabled = (leader < 0) ? 1 : 0;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // this thread, any cpu, all events in one group so they are read together
+    const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+    if(fd < 0)
+    {
+      error += std::string(error.empty() ? "" : ", ") + Name(e) + ": " + std::strerror(errno);
+      continue;
+    }
+
+    fds[e] = fd;
+    slot[e] = opened++;
+    if(leader < 0) {leader = fd;}
+  }
+
+  if(Good())
+  {
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#else
+  error = "perf_event_open needs Linux";
+#endif
+
+  return Good();
+}
+
+void Counters::Read(values_t & values) const
+{
+  values.fill(0);
+
+#ifdef __linux__
+  // nr, time enabled, time running, then one value per opened event
+  uint64_t buf[3 + EVENTS];
+  const ssize_t got = ::read(leader, buf, sizeof(buf));
+  if(got < static_cast<ssize_t>((3 + opened) * sizeof(uint64_t))) {return;}
+
+  const double scale = (buf[2] && buf[2] < buf[1]) ? static_cast<double>(buf[1]) / buf[2] : 1.0;
+  for(size_t e = 0; e < EVENTS; ++e)
+  {
+    if(Has(e)) {values[e] = static_cast<uint64_t>(buf[3 + slot[e]] * scale);}
+  }
+#endif
+}
+
+void Counters::Add(const size_t phase, const values_t & start, const values_t & end)
+{
+  ++calls[phase];
+  for(size_t e = 0; e < EVENTS; ++e) {totals[phase][e] += (start[e] < end[e]) ? end[e] - start[e] : 0;}
+}
+
+void Counters::Close()
+{
+#ifdef __linux__
+  for(int & fd : fds) {if(0 <= fd) {::close(fd);} fd = -1;}
+#endif
+  leader = -1;
+}
+
+void Counters::Write(const std::string & path, const size_t selection, const size_t diagnostic) const
+{
+  std::ofstream os(path);
+  if(!os)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;
+    return;
+  }
+
+  os << "selection,diagnostic,phase,calls";
+  for(size_t e = 0; e < EVENTS; ++e) {os << "," << Name(e);}
+  os << ",ipc,l1d_mpki,llc_mpki\n";
+
+  // counters that were not available are NA
+  auto field = [](const bool ok, const double v) {return ok ? std::to_string(v) : std::string("NA");};
+
+  for(size_t p = 0; p < Timing::PHASES; ++p)
+  {
+    if(calls[p] == 0) {continue;}
+    const values_t & t = totals[p];
+
+    os << selection << "," << diagnostic << "," << Timing::Name(p) << "," << calls[p];
+    for(size_t e = 0; e < EVENTS; ++e) {os << "," << (Has(e) ? std::to_string(t[e]) : std::string("NA"));}
+
+    // instructions per cycle and misses per thousand instructions
+    const bool ins = Has(INSTRUCTIONS) && t[INSTRUCTIONS];
+    os << "," << field(ins && Has(CYCLES) && t[CYCLES], ins && t[CYCLES] ? static_cast<double>(t[INSTRUCTIONS]) / t[CYCLES] : 0.0)
+       << "," << field(ins && Has(L1D_MISSES), ins ? 1000.0 * t[L1D_MISSES] / t[INSTRUCTIONS] : 0.0)
+       << "," << field(ins && Has(LLC_MISSES), ins ? 1000.0 * t[LLC_MISSES] / t[INSTRUCTIONS] : 0.0) << "\n";
+  }
+}
+
+const char * Counters::Name(const size_t event)
+{
+  static const char * names[EVENTS] = {"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+  return event < EVENTS ? names[event] : "unknown";
+}
+
+#endif
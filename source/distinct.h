@@ -0,0 +1,164 @@
+/// Groups equal double vectors (genomes, score vectors) with a hash index, so a population is grouped in O(N*M)
+/// Hash matches are verified element by element, so collisions never merge different vectors
+
+#ifndef DISTINCT_H
+#define DISTINCT_H
+
+///< standard headers
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+///< empirical headers
+#include "base/vector.h"
+
+class Distinct
+{
+  // object types we are using in this class
+  public:
+    // vectors being grouped
+    using vec_t = emp::vector<double>;
+    // vector of group or position ids
+    using ids_t = emp::vector<size_t>;
+
+
+  public:
+
+    ///< helper functions
+
+    // forget every group, keeping the memory for the next population
+    void Clear() {vecs.clear(); size.clear(); first.clear(); hash.clear(); std::fill(table.begin(), table.end(), EMPTY);}
+
+    // make room for n vectors without growing the table
+    void Reserve(const size_t n);
+
+    /**
+     * Add function:
+     *
+     * Puts a vector in the group of an equal vector added before, or starts a new group.
+     * Elements are compared with ==, so -0.0 and 0.0 are the same value and NaN never matches.
+     * The vector must stay alive until the next Clear.
+     *
+     * @param vec Vector being grouped.
+     * @param pos Position id of the vector (remembered for the first vector of a group).
+     *
+     * @return Group id (groups are numbered in order of first appearance).
+     */
+    size_t Add(const vec_t & vec, const size_t pos);
+
+    // number of distinct vectors seen
+    size_t GetCount() const {return size.size();}
+
+    // number of vectors in group g
+    size_t GetSize(const size_t g) const {emp_assert(g < size.size()); return size[g];}
+
+    // position id of the first vector in group g
+    size_t GetFirst(const size_t g) const {emp_assert(g < first.size()); return first[g];}
+
+    // largest group, ties go to the group that appeared first
+    size_t GetLargest() const;
+
+    // hash of a vector (-0.0 hashes like 0.0)
+    static uint64_t Hash(const vec_t & vec);
+
+  private:
+    // grow the table and place every group again
+    void Grow();
+
+    // first vector of every group
+    emp::vector<const vec_t *> vecs;
+    // group sizes
+    ids_t size;
+    // position id of the first vector of every group
+    ids_t first;
+    // hash of every group
+    emp::vector<uint64_t> hash;
+    // open addressing table of group ids (size is a power of two)
+    ids_t table;
+
+    // empty table slot
+    static constexpr size_t EMPTY = std::numeric_limits<size_t>::max();
+};
+
+void Distinct::Reserve(const size_t n)
+{
+  vecs.reserve(n); size.reserve(n); first.reserve(n); hash.reserve(n);
+
+  // keep the table at most half full
+  size_t cap = 16;
+  while(cap < 2 * n) {cap <<= 1;}
+  if(table.size() < cap) {table.assign(cap, EMPTY);}
+}
+
+size_t Distinct::Add(const vec_t & vec, const size_t pos)
+{
+  if(table.size() < 2 * (size.size() + 1)) {Grow();}
+
+  const uint64_t h = Hash(vec);
+  const size_t mask = table.size() - 1;
+
+  for(size_t s = h & mask; ; s = (s + 1) & mask)
+  {
+    // new group
+    if(table[s] == EMPTY)
+    {
+      table[s] = size.size();
+      vecs.push_back(&vec); size.push_back(1); first.push_back(pos); hash.push_back(h);
+      return table[s];
+    }
+
+    // verify the match, so a collision cannot merge two vectors
+    const size_t g = table[s];
+    if(hash[g] == h && *vecs[g] == vec)
+    {
+      ++size[g];
+      return g;
+    }
+  }
+}
+
+size_t Distinct::GetLargest() const
+{
+  // quick checks
+  emp_assert(0 < size.size());
+
+  size_t max = 0;
+  for(size_t g = 1; g < size.size(); ++g) {if(size[max] < size[g]) {max = g;}}
+
+  return max;
+}
+
+uint64_t Distinct::Hash(const vec_t & vec)
+{
+  uint64_t h = 0x9E3779B97F4A7C15ULL ^ vec.size();
+  for(const double v : vec)
+  {
+    // -0.0 == 0.0, so both have to land in the same slot
+    const double c = (v == 0.0) ? 0.0 : v;
+    uint64_t bits; std::memcpy(&bits, &c, sizeof(bits));
+
+    // splitmix64 finalizer over the running hash
+    h ^= bits + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+  }
+
+  return h;
+}
+
+void Distinct::Grow()
+{
+  table.assign(table.empty() ? 16 : 2 * table.size(), EMPTY);
+  const size_t mask = table.size() - 1;
+
+  for(size_t g = 0; g < hash.size(); ++g)
+  {
+    size_t s = hash[g] & mask;
+    while(table[s] != EMPTY) {s = (s + 1) & mask;}
+    table[s] = g;
+  }
+}
+
+#endif
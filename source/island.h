@@ -0,0 +1,299 @@
+/// Island model that runs several DiagWorld demes in one process (one thread each) with migration between them
+/// Migrants travel through lock-free single-producer/single-consumer queues, one per (source, destination) pair
+
+#ifndef ISLAND_H
+#define ISLAND_H
+
+///< standard headers
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+///< empirical headers
+#include "base/Ptr.h"
+#include "base/vector.h"
+
+///< experiment headers
+#include "config.h"
+#include "org.h"
+#include "stream.h"
+#include "termination.h"
+#include "trace.h"
+#include "world.h"
+
+/// Bounded lock-free queue with exactly one pushing thread and one popping thread
+template <typename T, size_t CAP>
+class SpscQueue
+{
+  static_assert(CAP && !(CAP & (CAP - 1)), "SpscQueue capacity must be a power of two");
+
+  public:
+
+    // producer side, false if the queue is full
+    bool Push(T && item)
+    {
+      const size_t t = tail.load(std::memory_order_relaxed);
+      if(t - head.load(std::memory_order_acquire) == CAP) {return false;}
+
+      buffer[t & (CAP - 1)] = std::move(item);
+      tail.store(t + 1, std::memory_order_release);
+      return true;
+    }
+
+    // consumer side, false if the queue is empty
+    bool Pop(T & item)
+    {
+      const size_t h = head.load(std::memory_order_relaxed);
+      if(h == tail.load(std::memory_order_acquire)) {return false;}
+
+      item = std::move(buffer[h & (CAP - 1)]);
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+
+  private:
+    // slots (only the producer writes [head, tail) and only the consumer reads them)
+    std::array<T, CAP> buffer;
+    // next slot to pop (consumer owned)
+    alignas(64) std::atomic<size_t> head{0};
+    // next slot to push (producer owned)
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+/**
+ * Migration Ring function:
+ *
+ * Order the islands pass migrants around in at a migration event.
+ * Every island sends one batch to the island after it and receives one from the island before it.
+ * Topology 0 always uses island id order, topology 1 draws a new order from the
+ * (seed, generation, MIGRATION) stream, so every island works out the same ring on its own.
+ *
+ * @param islands Number of islands.
+ * @param gen Generation of the migration event.
+ * @param topology Which topology (see MIGRATE_TOPOLOGY).
+ * @param seed Base seed of the run.
+ *
+ * @return Island ids in ring order.
+ */
+emp::vector<size_t> MigrationRing(const size_t islands, const size_t gen, const size_t topology, const uint64_t seed)
+{
+  emp::vector<size_t> ring(islands);
+  for(size_t k = 0; k < ring.size(); ++k) {ring[k] = k;}
+
+  if(topology == 1)
+  {
+    Stream stream(seed);
+    stream.Key(gen, Stream::MIGRATION, 0);
+    stream.Shuffle(ring);
+  }
+
+  return ring;
+}
+
+// position of an island in a migration ring
+size_t RingPosition(const emp::vector<size_t> & ring, const size_t k)
+{
+  size_t pos = 0;
+  while(ring[pos] != k) {++pos; emp_assert(pos < ring.size());}
+  return pos;
+}
+
+class IslandModel
+{
+  // object types we are using in this class
+  public:
+    // group of migrants sent at one migration event
+    struct batch_t
+    {
+      size_t gen = 0;
+      emp::vector<Org> orgs;
+    };
+    // queue between a pair of islands
+    using queue_t = SpscQueue<batch_t, 8>;
+    // vector of island ids
+    using ids_t = emp::vector<size_t>;
+
+
+  public:
+
+    IslandModel(DiaConfig & _config);
+
+    ~IslandModel();
+
+    ///< helper functions
+
+    // number of islands
+    size_t GetSize() const {return worlds.size();}
+
+    // world of island k
+    DiagWorld & GetWorld(const size_t k) {return *worlds[k];}
+
+    // run every island for MAX_GENS generations (one thread each), or until a termination criterion or a SIGINT/SIGTERM stops them all at one generation
+    void Run();
+
+  private:
+    // may island k start generation gen? (once a criterion fires on any island or a signal arrives, every island runs up to the same last generation)
+    bool Proceed(const size_t k, const size_t gen);
+
+    // migration event for island k (called by its world between evaluation and selection)
+    void Migrate(const size_t k);
+
+    // queue carrying migrants from island src to island dst
+    queue_t & Lane(const size_t src, const size_t dst) {return *lanes[src * GetSize() + dst];}
+
+  private:
+    // experiment configurations (shared by every island, except seed and output directory)
+    DiaConfig & config;
+
+    // per island configs and worlds
+    emp::vector<emp::Ptr<DiaConfig>> configs;
+    emp::vector<emp::Ptr<DiagWorld>> worlds;
+
+    // one queue per (source, destination) pair
+    emp::vector<emp::Ptr<queue_t>> lanes;
+
+    // timeline shared by every island (only used with TRACE_GENS > 0)
+    emp::Ptr<Trace> trace = nullptr;
+
+    // last generation every island runs after a criterion or signal (NONE until one of them comes up) and why
+    static constexpr size_t NONE = SIZE_MAX;
+    size_t stop_gen = NONE;
+    std::string stop_reason = "";
+    // generation each island last started
+    emp::vector<size_t> started;
+    // guards stop_gen and started
+    std::mutex stop_mutex;
+};
+
+IslandModel::IslandModel(DiaConfig & _config) : config(_config)
+{
+  // quick checks
+  emp_assert(1 < config.ISLANDS());
+  emp_assert(config.MIGRANT_CNT() <= config.POP_SIZE());
+
+  std::cerr << "==========================================" << std::endl;
+  std::cerr << "SETTING UP " << config.ISLANDS() << " ISLANDS" << std::endl;
+  std::cerr << "==========================================" << std::endl;
+
+  // SEED 0 (or less) draws one seed for the whole model, so island seeds and migration rings are keyed with it
+  if(config.SEED() <= 0) {config.SEED(Stream::DrawSeed());}
+
+  for(size_t k = 0; k < config.ISLANDS(); ++k)
+  {
+    // copy every setting, then give the island its own seed and output directory
+    emp::Ptr<DiaConfig> island = emp::NewPtr<DiaConfig>();
+    for(const auto & entry : config) {island->Set(entry.first, entry.second->GetValue());}
+    island->SEED(config.SEED() + static_cast<int>(k));
+    island->OUTPUT_DIR(config.OUTPUT_DIR() + "island_" + std::to_string(k) + "/");
+    MakeOutputDir(island->OUTPUT_DIR());
+    // islands share one trace, so their timelines line up
+    island->TRACE_GENS(0);
+
+    configs.push_back(island);
+    worlds.push_back(emp::NewPtr<DiagWorld>(*island));
+  }
+
+  if(config.TRACE_GENS())
+  {
+    trace = emp::NewPtr<Trace>(config.OUTPUT_DIR() + "trace.json", config.TRACE_FROM(), config.TRACE_GENS());
+    for(size_t k = 0; k < GetSize(); ++k) {worlds[k]->SetTrace(trace, k);}
+  }
+
+  lanes.resize(GetSize() * GetSize());
+  for(auto & lane : lanes) {lane = emp::NewPtr<queue_t>();}
+
+  started.resize(GetSize(), 0);
+
+  // migration happens right after evaluation, so migrants carry their scores with them
+  for(size_t k = 0; k < GetSize(); ++k)
+  {
+    worlds[k]->SetMigrate([this, k]() {Migrate(k);});
+  }
+}
+
+IslandModel::~IslandModel()
+{
+  for(auto & w : worlds) {w.Delete();}
+  for(auto & c : configs) {c.Delete();}
+  for(auto & l : lanes) {l.Delete();}
+  // written once every island is done
+  if(trace) {trace.Delete();}
+}
+
+void IslandModel::Run()
+{
+  emp::vector<std::thread> threads;
+
+  for(size_t k = 0; k < GetSize(); ++k)
+  {
+    threads.emplace_back([this, k]()
+    {
+      for(size_t ud = 0; ud <= config.MAX_GENS() && Proceed(k, ud); ud++) {worlds[k]->Update();}
+    });
+  }
+
+  for(auto & t : threads) {t.join();}
+}
+
+bool IslandModel::Proceed(const size_t k, const size_t gen)
+{
+  // did a criterion fire on this island's last generation? (only its own thread reads its world)
+  const bool stopped = worlds[k]->Stopped();
+
+  std::lock_guard<std::mutex> lock(stop_mutex);
+
+  // the first island to see a signal or its own criterion picks the generation after the furthest one started,
+  // so no island is past it and every migrant batch up to it still gets sent
+  if(stop_gen == NONE && (Termination::Signaled() || stopped))
+  {
+    stop_gen = std::min(*std::max_element(started.begin(), started.end()) + 1, config.MAX_GENS());
+    stop_reason = stopped ? "island_" + std::to_string(k) : "signal";
+
+    if(stopped) {std::cerr << "Island " << k << " stopped (" << worlds[k]->GetStopReason() << "), every island stops after gen=" << stop_gen << std::endl;}
+    else {std::cerr << "Signal caught, every island stops after gen=" << stop_gen << std::endl;}
+  }
+
+  if(stop_gen < gen) {return false;}
+
+  started[k] = gen;
+  // a run that reaches MAX_GENS is complete, signal or not
+  // (the island whose criterion fired keeps its own reason, the others stop because of it)
+  if(gen == stop_gen && gen < config.MAX_GENS()) {worlds[k]->Interrupt(stop_reason);}
+
+  return true;
+}
+
+void IslandModel::Migrate(const size_t k)
+{
+  DiagWorld & world = *worlds[k];
+  const size_t gen = world.GetUpdate();
+
+  // only migrate every MIGRATE_INTERVAL generations (never at the start)
+  if(config.MIGRATE_INTERVAL() == 0 || gen == 0 || gen % config.MIGRATE_INTERVAL()) {return;}
+
+  // find our neighbors in this event's ring
+  const ids_t ring = MigrationRing(GetSize(), gen, config.MIGRATE_TOPOLOGY(), static_cast<uint64_t>(config.SEED()));
+  const size_t pos = RingPosition(ring, k);
+  const size_t dst = ring[(pos + 1) % ring.size()];
+  const size_t src = ring[(pos + ring.size() - 1) % ring.size()];
+
+  // send first, so no island ever waits on one that is waiting on it
+  batch_t out;
+  out.gen = gen;
+  out.orgs = world.Emigrate(config.MIGRANT_CNT(), config.MIGRATE_ELITE());
+  while(!Lane(k, dst).Push(std::move(out))) {std::this_thread::yield();}
+
+  // every pair of islands keeps its batches in order, so the next one from src is this event's
+  batch_t in;
+  while(!Lane(src, k).Pop(in)) {std::this_thread::yield();}
+  emp_assert(in.gen == gen);
+
+  world.Immigrate(in.orgs);
+}
+
+#endif
@@ -0,0 +1,268 @@
+/// Island model with one DiagWorld deme per MPI rank (build with -DDIA_MPI, run with mpirun -np N)
+/// Migrants are serialized with cereal, global data (elite and unique objectives) comes from collective reductions
+
+#ifndef ISLAND_MPI_H
+#define ISLAND_MPI_H
+
+#ifdef DIA_MPI
+
+///< standard headers
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///< third party headers
+#include <mpi.h>
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/vector.hpp>
+
+///< empirical headers
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "data/DataFile.h"
+
+///< experiment headers
+#include "config.h"
+#include "island.h"
+#include "sampler.h"
+#include "stream.h"
+#include "termination.h"
+#include "world.h"
+
+class MpiIslandModel
+{
+  // object types we are using in this class
+  public:
+    // genomes as they travel (plain std::vector so cereal always knows the type)
+    using wire_t = std::vector<std::vector<double>>;
+    // vector of island ids
+    using ids_t = emp::vector<size_t>;
+
+
+  public:
+
+    MpiIslandModel(DiaConfig & _config);
+
+    ~MpiIslandModel()
+    {
+      if(data_file) {data_file.Delete();}
+      world.Delete();
+      island.Delete();
+    }
+
+    ///< helper functions
+
+    // number of islands (ranks)
+    size_t GetSize() const {return static_cast<size_t>(size);}
+
+    // run this rank's island for MAX_GENS generations, or until a termination criterion or a SIGINT/SIGTERM on any rank stops every rank at one generation
+    void Run();
+
+    /**
+     * Pack function:
+     *
+     * Serializes a migration batch with a cereal binary archive.
+     *
+     * @param gen Generation of the migration event.
+     * @param genomes Emigrant genomes.
+     *
+     * @return Bytes to send.
+     */
+    static std::string Pack(const uint64_t gen, const wire_t & genomes);
+
+    // inverse of Pack
+    static void Unpack(const std::string & bytes, uint64_t & gen, wire_t & genomes);
+
+  private:
+    // migration event (called by the world between evaluation and selection)
+    void Migrate();
+
+    // reduce the last recorded generation across ranks and write the global row (rank 0 only)
+    void RecordGlobal();
+
+  private:
+    // experiment configurations (shared by every rank, except seed and output directory)
+    DiaConfig & config;
+    // this rank's config and world
+    emp::Ptr<DiaConfig> island;
+    emp::Ptr<DiagWorld> world;
+
+    // rank and number of ranks
+    int rank = 0;
+    int size = 1;
+
+    // global data file (rank 0 only) and the values it writes
+    emp::Ptr<emp::DataFile> data_file = nullptr;
+    // global rows follow the DATA_SAMPLING schedule (events differ between ranks, so they are left out)
+    Sampler sampler;
+    size_t glb_gen = 0;
+    double glb_ele_agg = 0.0;
+    size_t glb_ele_cnt = 0;
+    size_t glb_uni_obj = 0;
+
+    // message tag for migrants (MPI keeps messages between a pair of ranks in order)
+    static constexpr int MIGRATE_TAG = 17;
+};
+
+MpiIslandModel::MpiIslandModel(DiaConfig & _config) : config(_config), sampler(_config)
+{
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // quick checks
+  emp_assert(config.MIGRANT_CNT() <= config.POP_SIZE());
+
+  // SEED 0 (or less) draws one seed on rank 0 for every rank, so island seeds and migration rings are keyed with it
+  if(config.SEED() <= 0)
+  {
+    int seed = Stream::DrawSeed();
+    MPI_Bcast(&seed, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    config.SEED(seed);
+  }
+
+  // copy every setting, then give the island its own seed and output directory
+  island = emp::NewPtr<DiaConfig>();
+  for(const auto & entry : config) {island->Set(entry.first, entry.second->GetValue());}
+  island->SEED(config.SEED() + rank);
+  island->OUTPUT_DIR(config.OUTPUT_DIR() + "island_" + std::to_string(rank) + "/");
+  MakeOutputDir(island->OUTPUT_DIR());
+
+  world = emp::NewPtr<DiagWorld>(*island);
+  world->SetMigrate([this]() {Migrate();});
+
+  if(rank != 0) {return;}
+
+  std::cerr << "Running " << size << " MPI islands, global data in " << config.OUTPUT_DIR() << "data.csv" << std::endl;
+
+  data_file = emp::NewPtr<emp::DataFile>(config.OUTPUT_DIR() + "data.csv");
+  data_file->AddFun<size_t>([this]() {return glb_gen;}, "gen", "Current generation at!");
+  data_file->AddFun<double>([this]() {return glb_ele_agg;}, "ele_agg_per", "Elite solution aggregate performance across all islands!");
+  data_file->AddFun<size_t>([this]() {return glb_ele_cnt;}, "ele_opt_cnt", "Elite solution optimized objective count across all islands!");
+  data_file->AddFun<size_t>([this]() {return glb_uni_obj;}, "pop_uni_obj", "Number of unique optimized traits across all islands!");
+  data_file->PrintHeaderKeys();
+}
+
+void MpiIslandModel::Run()
+{
+  for(size_t ud = 0; ud <= config.MAX_GENS(); ud++)
+  {
+    // every rank learns whether any rank caught a signal (2) or met its criterion (1) before the same generation,
+    // so they all make it their last (ties go to the lowest rank)
+    struct {int cause; int rank;} local = {Termination::Signaled() ? 2 : (world->Stopped() ? 1 : 0), rank}, any = {0, 0};
+    MPI_Allreduce(&local, &any, 1, MPI_2INT, MPI_MAXLOC, MPI_COMM_WORLD);
+    if(any.cause && ud < config.MAX_GENS()) {world->Interrupt(any.cause == 2 ? "signal" : "island_" + std::to_string(any.rank));}
+
+    world->Update();
+
+    // every rank takes part in the reductions on the same generations
+    const size_t gen = world->GetCensus().update;
+    if(sampler.Scheduled(gen) || any.cause) {RecordGlobal();}
+
+    if(any.cause)
+    {
+      if(rank == 0 && any.cause == 2) {std::cerr << "Signal caught, every rank stopped after gen=" << gen << std::endl;}
+      if(rank == 0 && any.cause == 1) {std::cerr << "Island " << any.rank << " stopped, every rank stopped after gen=" << gen << std::endl;}
+      break;
+    }
+  }
+}
+
+std::string MpiIslandModel::Pack(const uint64_t gen, const wire_t & genomes)
+{
+  std::ostringstream os;
+  {
+    cereal::BinaryOutputArchive archive(os);
+    archive(gen, genomes);
+  }
+
+  return os.str();
+}
+
+void MpiIslandModel::Unpack(const std::string & bytes, uint64_t & gen, wire_t & genomes)
+{
+  std::istringstream is(bytes);
+  cereal::BinaryInputArchive archive(is);
+  archive(gen, genomes);
+}
+
+void MpiIslandModel::Migrate()
+{
+  const size_t gen = world->GetUpdate();
+
+  // only migrate every MIGRATE_INTERVAL generations (never at the start)
+  if(config.MIGRATE_INTERVAL() == 0 || gen == 0 || gen % config.MIGRATE_INTERVAL()) {return;}
+
+  // find our neighbors in this event's ring
+  const ids_t ring = MigrationRing(GetSize(), gen, config.MIGRATE_TOPOLOGY(), static_cast<uint64_t>(config.SEED()));
+  const size_t pos = RingPosition(ring, static_cast<size_t>(rank));
+  const int dst = static_cast<int>(ring[(pos + 1) % ring.size()]);
+  const int src = static_cast<int>(ring[(pos + ring.size() - 1) % ring.size()]);
+
+  // only genomes travel, the receiver evaluates them again
+  wire_t out;
+  for(const auto & org : world->Emigrate(config.MIGRANT_CNT(), config.MIGRATE_ELITE()))
+  {
+    out.emplace_back(org.GetGenome().begin(), org.GetGenome().end());
+  }
+  const std::string bytes = Pack(gen, out);
+
+  // non-blocking send first, so no rank ever waits on one that is waiting on it
+  MPI_Request request;
+  MPI_Isend(bytes.data(), static_cast<int>(bytes.size()), MPI_BYTE, dst, MIGRATE_TAG, MPI_COMM_WORLD, &request);
+
+  // messages between a pair of ranks stay in order, so the next one from src is this event's
+  MPI_Status status;
+  MPI_Probe(src, MIGRATE_TAG, MPI_COMM_WORLD, &status);
+  int cnt = 0;
+  MPI_Get_count(&status, MPI_BYTE, &cnt);
+
+  std::string in(static_cast<size_t>(cnt), '\0');
+  MPI_Recv(&in[0], cnt, MPI_BYTE, src, MIGRATE_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+  uint64_t in_gen = 0; wire_t genomes;
+  Unpack(in, in_gen, genomes);
+  emp_assert(in_gen == gen);
+
+  DiagWorld::gmatrix_t immigrants;
+  for(const auto & g : genomes) {immigrants.emplace_back(g.begin(), g.end());}
+  world->Immigrate(immigrants);
+}
+
+void MpiIslandModel::RecordGlobal()
+{
+  const Census & census = world->GetCensus();
+
+  // local elite (ties to lowest id), then global elite (ties to lowest rank)
+  const size_t elite = std::distance(census.agg.begin(), std::max_element(census.agg.begin(), census.agg.end()));
+  struct {double agg; int rank;} local = {census.agg[elite], rank}, global = {0.0, 0};
+  MPI_Allreduce(&local, &global, 1, MPI_DOUBLE_INT, MPI_MAXLOC, MPI_COMM_WORLD);
+
+  // only the elite's rank contributes its count
+  unsigned long cnt = (global.rank == rank) ? census.count[elite] : 0;
+  unsigned long ele_cnt = 0;
+  MPI_Reduce(&cnt, &ele_cnt, 1, MPI_UNSIGNED_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+
+  // objectives optimized by anyone on this island, or'ed across islands
+  std::vector<unsigned char> local_obj(config.OBJECTIVE_CNT(), 0);
+  for(const auto & opt : census.optimal)
+  {
+    for(size_t o = 0; o < local_obj.size(); ++o) {local_obj[o] |= static_cast<unsigned char>((*opt)[o]);}
+  }
+  std::vector<unsigned char> global_obj(local_obj.size(), 0);
+  MPI_Reduce(local_obj.data(), global_obj.data(), static_cast<int>(local_obj.size()), MPI_UNSIGNED_CHAR, MPI_BOR, 0, MPI_COMM_WORLD);
+
+  if(rank != 0) {return;}
+
+  glb_gen = census.update;
+  glb_ele_agg = global.agg;
+  glb_ele_cnt = static_cast<size_t>(ele_cnt);
+  glb_uni_obj = static_cast<size_t>(std::count(global_obj.begin(), global_obj.end(), 1));
+  data_file->Update();
+}
+
+#endif // DIA_MPI
+
+#endif
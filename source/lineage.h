@@ -0,0 +1,405 @@
+/// Lineage tracking: which taxon every position id belongs to, and a table of ancestor taxa pruned down to the lineages
+/// that are still alive (extinct branches are dropped, unbranching ancestors are folded into their only child)
+/// Writes phylogenetic diversity rows to phylo.csv and snapshots of the table to phylo_<gen>.csv
+
+#ifndef LINEAGE_H
+#define LINEAGE_H
+
+///< standard headers
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+///< empirical headers
+#include "base/vector.h"
+
+class Lineage
+{
+  // object types we are using in this class
+  public:
+    // taxon id, an index into the table
+    using id_t = uint32_t;
+    // no taxon (parent of a root)
+    static constexpr id_t NONE = std::numeric_limits<id_t>::max();
+
+    // one taxon (a clone stays in its parent's taxon, every mutated offspring starts a new one)
+    struct Node
+    {
+      // ancestor in the table (NONE for a root)
+      id_t parent = NONE;
+      // children in the table, and all their ids xor-ed together (the only child's id when there is one)
+      id_t kids = 0;
+      id_t kid_xor = 0;
+      // position ids holding this taxon
+      id_t alive = 0;
+      // taxa between this one and its root
+      uint32_t depth = 0;
+      // taxa this node stands for (itself plus the unbranching ancestors folded into it, 0 once freed)
+      uint32_t span = 0;
+      // first generation the taxon was alive in
+      uint64_t birth = 0;
+      // aggregate score the first time it was evaluated (NaN until then)
+      double fitness = std::numeric_limits<double>::quiet_NaN();
+    };
+
+
+  public:
+
+    /**
+     * Constructor:
+     *
+     * @param path phylo.csv to write.
+     * @param _pop_size Number of position ids.
+     * @param _phenotypes Keep the score vector of every taxon?
+     * @param from Generation a resumed run carries on from (rows it already has before that are kept).
+     */
+    Lineage(const std::string & path, const size_t _pop_size, const bool _phenotypes, const size_t from = 0);
+
+    ///< helper functions
+
+    // every position id starts its own root at generation gen
+    void Found(const size_t gen);
+
+    // position id slot was evaluated, so its taxon gets its fitness (and score vector) if it has none yet
+    void Record(const size_t slot, const double fitness, const emp::vector<double> & score);
+
+    // position id slot was taken by an immigrant, which starts a new root
+    void Arrive(const size_t slot, const size_t gen);
+
+    /**
+     * Birth function:
+     *
+     * Moves the table on to the offspring of generation gen, with offspring i taken from position id parents[i].
+     *
+     * @param parents Parent position id of every offspring.
+     * @param clone Callable telling if offspring i is an unmutated clone (clones stay in their parent's taxon).
+     * @param gen Generation the parents were alive in.
+     */
+    template <typename CLONE>
+    void Birth(const emp::vector<size_t> & parents, CLONE && clone, const size_t gen);
+
+    // phylo.csv row for generation gen
+    void Row(const size_t gen);
+
+    // every taxon still in the table into path
+    void Snapshot(const std::string & path) const;
+
+    // table state for a checkpoint, and back (false if the state does not fit this population)
+    void Save(std::ostream & os) const;
+    bool Load(std::istream & is);
+
+    ///< getters
+
+    // distinct taxa alive right now
+    size_t GetTaxa() const {return taxa;}
+    // nodes kept in the table
+    size_t GetNodes() const {return nodes.size() - free_ids.size();}
+    // taxa the table stands for (folded ones included)
+    size_t GetTreeTaxa() const {return tree_taxa;}
+    size_t GetRoots() const {return roots;}
+    // phylogenetic diversity: taxa in the tree of living lineages minus one
+    size_t GetDiversity() const {return tree_taxa ? tree_taxa - 1 : 0;}
+    id_t GetTaxon(const size_t slot) const {return slots[slot];}
+    const Node & GetNode(const id_t id) const {return nodes[id];}
+
+  private:
+    // new taxon under parent (NONE for a root), alive at one position id
+    id_t Add(const id_t parent, const uint64_t birth);
+
+    // a position id let go of taxon id: prune it if nothing alive descends from it, fold it if it stopped branching
+    void Release(id_t id);
+
+    // taxon at the top of the tree holding id
+    id_t Root(id_t id) const;
+
+  private:
+    size_t pop_size;
+    bool phenotypes;
+
+    // taxon of every position id, and the next generation's being filled in
+    emp::vector<id_t> slots;
+    emp::vector<id_t> next;
+
+    // table and the ids free to reuse
+    emp::vector<Node> nodes;
+    emp::vector<id_t> free_ids;
+    // score vectors by taxon id (only with phenotypes)
+    emp::vector<emp::vector<double>> scores;
+
+    size_t taxa = 0;
+    size_t tree_taxa = 0;
+    size_t roots = 0;
+
+    std::ofstream file;
+};
+
+Lineage::Lineage(const std::string & path, const size_t _pop_size, const bool _phenotypes, const size_t from)
+  : pop_size(_pop_size), phenotypes(_phenotypes), slots(_pop_size, NONE), next(_pop_size, NONE)
+{
+  // a resumed run keeps the rows written before its checkpoint (later ones are written again)
+  std::string kept;
+  if(0 < from)
+  {
+    std::ifstream is(path);
+    std::string line;
+    std::getline(is, line);
+    while(std::getline(is, line))
+    {
+      if(std::stoull("0" + line.substr(0, line.find(','))) < from) {kept += line + "\n";}
+    }
+  }
+
+  file.open(path, std::ios::trunc);
+  if(!file) {std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;}
+  file << "gen,taxa,nodes,roots,diversity,mrca_gen,mrca_depth,mean_depth,entropy\n" << kept << std::flush;
+}
+
+void Lineage::Found(const size_t gen)
+{
+  for(size_t i = 0; i < pop_size; ++i)
+  {
+    if(slots[i] != NONE) {const id_t old = slots[i]; --nodes[old].alive; if(!nodes[old].alive) {--taxa;} Release(old);}
+    slots[i] = Add(NONE, gen);
+  }
+}
+
+void Lineage::Record(const size_t slot, const double fitness, const emp::vector<double> & score)
+{
+  Node & node = nodes[slots[slot]];
+  if(!std::isnan(node.fitness)) {return;}
+
+  node.fitness = fitness;
+  if(phenotypes) {scores[slots[slot]].assign(score.begin(), score.end());}
+}
+
+void Lineage::Arrive(const size_t slot, const size_t gen)
+{
+  // quick checks
+  emp_assert(slot < pop_size); emp_assert(slots[slot] != NONE);
+
+  const id_t old = slots[slot];
+  slots[slot] = Add(NONE, gen);
+  if(--nodes[old].alive == 0) {--taxa;}
+  Release(old);
+}
+
+template <typename CLONE>
+void Lineage::Birth(const emp::vector<size_t> & parents, CLONE && clone, const size_t gen)
+{
+  // quick checks
+  emp_assert(parents.size() == pop_size);
+
+  // offspring first, so parents stay referenced while their own taxa are let go
+  for(size_t i = 0; i < pop_size; ++i)
+  {
+    const id_t parent = slots[parents[i]];
+    if(clone(i)) {++nodes[parent].alive; next[i] = parent;}
+    else {next[i] = Add(parent, gen + 1);}
+  }
+
+  for(size_t i = 0; i < pop_size; ++i)
+  {
+    const id_t old = slots[i];
+    if(--nodes[old].alive == 0) {--taxa;}
+    Release(old);
+  }
+
+  std::swap(slots, next);
+}
+
+Lineage::id_t Lineage::Add(const id_t parent, const uint64_t birth)
+{
+  id_t id;
+  if(free_ids.size()) {id = free_ids.back(); free_ids.pop_back();}
+  else
+  {
+    id = static_cast<id_t>(nodes.size());
+    nodes.emplace_back();
+    if(phenotypes) {scores.emplace_back();}
+  }
+
+  Node & node = nodes[id];
+  node = Node();
+  node.parent = parent;
+  node.alive = 1;
+  node.span = 1;
+  node.birth = birth;
+  if(phenotypes) {scores[id].clear();}
+
+  if(parent == NONE) {++roots;}
+  else
+  {
+    Node & up = nodes[parent];
+    node.depth = up.depth + 1;
+    ++up.kids;
+    up.kid_xor ^= id;
+  }
+
+  ++taxa;
+  ++tree_taxa;
+  return id;
+}
+
+void Lineage::Release(id_t id)
+{
+  while(id != NONE)
+  {
+    Node & node = nodes[id];
+    if(node.alive) {return;}
+
+    const id_t parent = node.parent;
+
+    // extinct: drop it and check its parent, which lost a child
+    if(node.kids == 0)
+    {
+      tree_taxa -= node.span;
+      if(parent == NONE) {--roots;}
+      else {--nodes[parent].kids; nodes[parent].kid_xor ^= id;}
+
+      node.span = 0;
+      free_ids.push_back(id);
+      id = parent;
+      continue;
+    }
+
+    // unbranching: its only child takes its place (and keeps counting it as an ancestor)
+    if(node.kids == 1)
+    {
+      const id_t kid = node.kid_xor;
+      nodes[kid].parent = parent;
+      nodes[kid].span += node.span;
+      if(parent != NONE) {nodes[parent].kid_xor ^= id ^ kid;}
+
+      node.span = 0;
+      free_ids.push_back(id);
+    }
+
+    return;
+  }
+}
+
+Lineage::id_t Lineage::Root(id_t id) const
+{
+  while(nodes[id].parent != NONE) {id = nodes[id].parent;}
+  return id;
+}
+
+void Lineage::Row(const size_t gen)
+{
+  // depth and entropy from the position ids (every id adds its share of its taxon's term)
+  double depth = 0.0, entropy = 0.0;
+  for(const id_t id : slots)
+  {
+    depth += nodes[id].depth;
+    entropy -= std::log(static_cast<double>(nodes[id].alive) / pop_size);
+  }
+
+  file << gen << "," << taxa << "," << GetNodes() << "," << roots << "," << GetDiversity() << ",";
+
+  // with a single root, the table is folded down to the most recent common ancestor
+  if(roots == 1)
+  {
+    const Node & mrca = nodes[Root(slots[0])];
+    file << mrca.birth << "," << mrca.depth << ",";
+  }
+  else {file << "NA,NA,";}
+
+  file << std::setprecision(6) << depth / pop_size << "," << entropy / pop_size << "\n";
+}
+
+void Lineage::Snapshot(const std::string & path) const
+{
+  std::ofstream os(path);
+  if(!os)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;
+    return;
+  }
+
+  os << "id,parent,birth,depth,span,alive,fitness" << (phenotypes ? ",phenotype" : "") << "\n";
+  os << std::setprecision(10);
+  for(size_t id = 0; id < nodes.size(); ++id)
+  {
+    const Node & node = nodes[id];
+    if(node.span == 0) {continue;}
+
+    os << id << ",";
+    if(node.parent == NONE) {os << "NA";} else {os << node.parent;}
+    os << "," << node.birth << "," << node.depth << "," << node.span << "," << node.alive << ",";
+    if(std::isnan(node.fitness)) {os << "NA";} else {os << node.fitness;}
+
+    if(phenotypes)
+    {
+      os << ",\"";
+      for(size_t j = 0; j < scores[id].size(); ++j) {os << (j ? " " : "") << scores[id][j];}
+      os << "\"";
+    }
+    os << "\n";
+  }
+}
+
+namespace lineage
+{
+  template <typename T>
+  void Put(std::ostream & os, const T & val) {os.write(reinterpret_cast<const char *>(&val), sizeof(T));}
+
+  template <typename T>
+  bool Get(std::istream & is, T & val) {return static_cast<bool>(is.read(reinterpret_cast<char *>(&val), sizeof(T)));}
+
+  template <typename T>
+  void PutVec(std::ostream & os, const emp::vector<T> & vec)
+  {
+    Put(os, static_cast<uint64_t>(vec.size()));
+    os.write(reinterpret_cast<const char *>(vec.data()), vec.size() * sizeof(T));
+  }
+
+  template <typename T>
+  bool GetVec(std::istream & is, emp::vector<T> & vec)
+  {
+    uint64_t n = 0;
+    if(!Get(is, n)) {return false;}
+    vec.resize(n);
+    return static_cast<bool>(is.read(reinterpret_cast<char *>(vec.data()), n * sizeof(T)));
+  }
+}
+
+void Lineage::Save(std::ostream & os) const
+{
+  lineage::Put(os, static_cast<uint64_t>(taxa)); lineage::Put(os, static_cast<uint64_t>(tree_taxa)); lineage::Put(os, static_cast<uint64_t>(roots));
+  lineage::PutVec(os, slots);
+  lineage::PutVec(os, nodes);
+  lineage::PutVec(os, free_ids);
+
+  // score vectors of the taxa still in the table
+  lineage::Put(os, static_cast<uint8_t>(phenotypes));
+  if(!phenotypes) {return;}
+  for(size_t id = 0; id < nodes.size(); ++id) {if(nodes[id].span) {lineage::PutVec(os, scores[id]);}}
+}
+
+bool Lineage::Load(std::istream & is)
+{
+  uint64_t t = 0, tt = 0, r = 0;
+  uint8_t phen = 0;
+  bool good = lineage::Get(is, t) && lineage::Get(is, tt) && lineage::Get(is, r);
+  good = good && lineage::GetVec(is, slots) && lineage::GetVec(is, nodes) && lineage::GetVec(is, free_ids);
+  good = good && lineage::Get(is, phen) && static_cast<bool>(phen) == phenotypes && slots.size() == pop_size;
+  if(!good) {return false;}
+
+  taxa = t; tree_taxa = tt; roots = r;
+  for(const id_t id : slots) {if(nodes.size() <= id) {return false;}}
+
+  scores.clear();
+  if(phenotypes)
+  {
+    scores.resize(nodes.size());
+    for(size_t id = 0; good && id < nodes.size(); ++id) {if(nodes[id].span) {good = lineage::GetVec(is, scores[id]);}}
+  }
+
+  return good;
+}
+
+#endif
@@ -0,0 +1,304 @@
+/// Console logging: leveled messages held in a per-sink buffer and written out in chunks instead of flushing every line,
+/// with an optional floor on the seconds between progress lines and optional JSON lines for machine readers
+/// A logger is used by one thread at a time (setup runs on the main thread, the pipe thread may take over afterwards)
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+///< standard headers
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+
+///< empirical headers
+#include "base/vector.h"
+
+class Logger
+{
+  // object types we are using in this class
+  public:
+    // clock for rate limiting and flush ages
+    using clock_t = std::chrono::steady_clock;
+
+    // message levels, a logger prints its level and everything below it
+    enum Level : size_t {ERROR = 0, WARN = 1, INFO = 2, DEBUG = 3};
+
+    /// One structured line: an optional message plus key/value fields
+    /// (plain text prints the message, or the fields as "key=value, ..." when there is none)
+    class Record
+    {
+      public:
+        Record(const std::string & _msg = "") : msg(_msg) {;}
+
+        template <typename T>
+        Record & Add(const std::string & key, const T & val);
+
+      private:
+        friend class Logger;
+
+        std::string msg;
+        emp::vector<std::string> keys;
+        // value as plain text prints it, and as JSON prints it
+        emp::vector<std::string> text;
+        emp::vector<std::string> json;
+    };
+
+
+  public:
+
+    /**
+     * Constructor:
+     *
+     * @param os Stream the buffered lines end up in (must outlive the logger).
+     * @param _level Most detailed level printed.
+     * @param _capacity Bytes held before they are written out (0 writes every line).
+     * @param _json Print JSON lines instead of plain text?
+     */
+    Logger(std::ostream & os, const size_t _level = INFO, const size_t _capacity = 1 << 16, const bool _json = false);
+
+    // writes whatever is still held
+    ~Logger() {Flush();}
+
+    ///< helper functions
+
+    // change the level, buffer size and format (setup)
+    void Configure(const size_t _level, const size_t _capacity, const bool _json);
+
+    // send the lines somewhere else from now on
+    void SetTarget(std::ostream & os) {Flush(); target = &os;}
+
+    // is a line at this level printed?
+    bool Enabled(const size_t lvl) const {return lvl <= level;}
+
+    // free text streams, one message per line
+    std::ostream & Error() {return At(ERROR);}
+    std::ostream & Warn() {return At(WARN);}
+    std::ostream & Info() {return At(INFO);}
+    std::ostream & Debug() {return At(DEBUG);}
+
+    // print a structured line
+    void Write(const size_t lvl, const Record & rec);
+
+    // rate limit: true at most once every `seconds` (always true for seconds <= 0)
+    bool Due(const double seconds);
+
+    // write out everything held
+    void Flush();
+
+    // write out held lines once they are a second old (called every generation, so a quiet stretch does not hold them back)
+    void Tick() {if(!buffer.empty() && Stale()) {Flush();}}
+
+    // JSON string literal for s
+    static std::string Quote(const std::string & s);
+
+  private:
+    // streambuf collecting free text into whole lines
+    class Lines : public std::streambuf
+    {
+      public:
+        Lines(Logger & _owner) : owner(_owner) {;}
+
+      protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char * s, std::streamsize n) override;
+
+      private:
+        Logger & owner;
+    };
+
+    // free text stream for lvl (a stream that drops everything when lvl is not printed)
+    std::ostream & At(const size_t lvl);
+
+    // add one finished line to the buffer, writing the buffer out when it is due
+    void Emit(const size_t lvl, const std::string & msg, const Record * rec);
+
+    // seconds since the logger started
+    double Elapsed() const {return std::chrono::duration<double>(clock_t::now() - begin).count();}
+
+    // was the buffer last written out a second or more ago?
+    bool Stale() const {return 1.0 <= std::chrono::duration<double>(clock_t::now() - flushed).count();}
+
+  private:
+    // where lines go
+    std::ostream * target;
+    // most detailed level printed
+    size_t level;
+    // bytes held before writing out
+    size_t capacity;
+    // JSON lines?
+    bool json;
+
+    // held output
+    std::string buffer;
+    // free text line being collected, and its level
+    std::string line;
+    size_t cur = INFO;
+    Lines lines;
+    std::ostream text;
+    std::ostream mute{nullptr};
+
+    // when the logger started, last wrote out, and last let a rate limited line through
+    clock_t::time_point begin;
+    clock_t::time_point flushed;
+    clock_t::time_point passed;
+    bool passed_once = false;
+};
+
+template <typename T>
+Logger::Record & Logger::Record::Add(const std::string & key, const T & val)
+{
+  std::ostringstream os;
+  os << val;
+
+  keys.push_back(key);
+  text.push_back(os.str());
+
+  // JSON has no inf or nan
+  if constexpr (std::is_arithmetic_v<T>) {json.push_back(std::isfinite(static_cast<double>(val)) ? os.str() : "null");}
+  else {json.push_back(Quote(os.str()));}
+
+  return *this;
+}
+
+Logger::Logger(std::ostream & os, const size_t _level, const size_t _capacity, const bool _json)
+  : target(&os), level(_level), capacity(_capacity), json(_json), lines(*this), text(&lines),
+    begin(clock_t::now()), flushed(begin), passed(begin)
+{
+  buffer.reserve(capacity);
+}
+
+void Logger::Configure(const size_t _level, const size_t _capacity, const bool _json)
+{
+  Flush();
+  level = _level;
+  capacity = _capacity;
+  json = _json;
+  buffer.reserve(capacity);
+}
+
+void Logger::Write(const size_t lvl, const Record & rec)
+{
+  if(!Enabled(lvl)) {return;}
+  Emit(lvl, rec.msg, &rec);
+}
+
+bool Logger::Due(const double seconds)
+{
+  if(seconds <= 0.0) {return true;}
+
+  const auto now = clock_t::now();
+  if(passed_once && std::chrono::duration<double>(now - passed).count() < seconds) {return false;}
+
+  passed = now;
+  passed_once = true;
+  return true;
+}
+
+void Logger::Flush()
+{
+  flushed = clock_t::now();
+  if(buffer.empty()) {return;}
+
+  target->write(buffer.data(), buffer.size());
+  target->flush();
+  buffer.clear();
+}
+
+std::string Logger::Quote(const std::string & s)
+{
+  std::string out = "\"";
+  for(const char c : s)
+  {
+    switch(c)
+    {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\t': out += "\\t"; break;
+      case '\r': out += "\\r"; break;
+      default:
+        if(static_cast<unsigned char>(c) < 0x20)
+        {
+          char hex[8];
+          std::snprintf(hex, sizeof(hex), "\\u%04x", static_cast<unsigned>(c));
+          out += hex;
+        }
+        else {out += c;}
+    }
+  }
+  out += "\"";
+
+  return out;
+}
+
+std::ostream & Logger::At(const size_t lvl)
+{
+  if(!Enabled(lvl)) {return mute;}
+
+  cur = lvl;
+  return text;
+}
+
+void Logger::Emit(const size_t lvl, const std::string & msg, const Record * rec)
+{
+  static const char * names[] = {"error", "warn", "info", "debug"};
+
+  if(json)
+  {
+    // blank spacer lines carry nothing for a machine reader
+    if(msg.empty() && (rec == nullptr || rec->keys.empty())) {return;}
+
+    char time[32];
+    std::snprintf(time, sizeof(time), "%.3f", Elapsed());
+    buffer += "{\"time\":"; buffer += time;
+    buffer += ",\"level\":\""; buffer += names[lvl < 4 ? lvl : 3]; buffer += "\"";
+    if(!msg.empty()) {buffer += ",\"msg\":"; buffer += Quote(msg);}
+    if(rec)
+    {
+      for(size_t i = 0; i < rec->keys.size(); ++i) {buffer += ","; buffer += Quote(rec->keys[i]); buffer += ":"; buffer += rec->json[i];}
+    }
+    buffer += "}\n";
+  }
+  else if(!msg.empty() || rec == nullptr) {buffer += msg; buffer += '\n';}
+  else
+  {
+    for(size_t i = 0; i < rec->keys.size(); ++i)
+    {
+      if(i) {buffer += ", ";}
+      buffer += rec->keys[i]; buffer += "="; buffer += rec->text[i];
+    }
+    buffer += '\n';
+  }
+
+  // problems go out right away, everything else once the buffer fills or has been held for a second
+  if(lvl <= WARN || capacity <= buffer.size() || Stale()) {Flush();}
+}
+
+Logger::Lines::int_type Logger::Lines::overflow(int_type ch)
+{
+  if(traits_type::eq_int_type(ch, traits_type::eof())) {return traits_type::not_eof(ch);}
+
+  const char c = traits_type::to_char_type(ch);
+  xsputn(&c, 1);
+
+  return ch;
+}
+
+std::streamsize Logger::Lines::xsputn(const char * s, std::streamsize n)
+{
+  // every newline finishes a message
+  for(std::streamsize i = 0; i < n; ++i)
+  {
+    if(s[i] == '\n') {owner.Emit(owner.cur, owner.line, nullptr); owner.line.clear();}
+    else {owner.line += s[i];}
+  }
+
+  return n;
+}
+
+#endif
@@ -0,0 +1,268 @@
+/// Population and parent statistics of one census, computed in a single fused pass over its arrays
+/// Only the metrics a generation's outputs ask for are computed, everything else is left untouched
+
+#ifndef METRICS_H
+#define METRICS_H
+
+///< standard headers
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+///< empirical headers
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "data/DataNode.h"
+
+///< experiment headers
+#include "distinct.h"
+#include "org.h"
+
+/// Read only snapshot of everything data tracking needs from one generation
+/// Genomes, score vectors and optimal vectors are shared with the orgs, so taking one never copies them
+struct Census
+{
+  // generation the snapshot was taken at
+  size_t update = 0;
+  // aggregate score by position id
+  emp::vector<double> agg;
+  // optimized objective count by position id
+  emp::vector<size_t> count;
+  // starting position by position id
+  emp::vector<size_t> start;
+  // genome by position id
+  emp::vector<std::shared_ptr<const Org::genome_t>> genome;
+  // score vector by position id
+  emp::vector<std::shared_ptr<const Org::score_t>> score;
+  // optimal vector by position id
+  emp::vector<std::shared_ptr<const Org::optimal_t>> optimal;
+  // parent ids picked by the selection scheme
+  emp::vector<size_t> parents;
+  // solutions evaluated up to and including this generation
+  size_t evals = 0;
+  // objective evaluations (objectives selection used, per evaluated solution) up to and including this generation
+  size_t obj_evals = 0;
+};
+
+class Metrics
+{
+  // object types we are using in this class
+  public:
+    // data nodes (the monitors keep doing the arithmetic, so the numbers match the per metric passes bit for bit)
+    using nodef_t = emp::Ptr<emp::DataMonitor<double>>;
+    using nodeo_t = emp::Ptr<emp::DataMonitor<size_t>>;
+    // bitmap word
+    using word_t = uint64_t;
+    // bitmap over ids
+    using bits_t = emp::vector<word_t>;
+
+    // metric groups a generation's outputs can ask for (combine with |)
+    enum Need : size_t
+    {
+      NONE = 0,
+      // elite and optimized positions (console line, termination)
+      BEST = 1,
+      // unique optimized objectives (stagnation on pop_uni_obj)
+      UNIQUE = 2,
+      // data nodes, the common solution and the distinct counts
+      STATS = 4,
+      // everything in a data.csv row
+      ROW = BEST | UNIQUE | STATS
+    };
+
+
+  public:
+
+    Metrics()
+    {
+      pop_fit.New(); pop_opti.New(); pnt_fit.New(); pnt_opti.New();
+    }
+
+    ~Metrics()
+    {
+      pop_fit.Delete();
+      pop_opti.Delete();
+      pnt_fit.Delete();
+      pnt_opti.Delete();
+    }
+
+    ///< helper functions
+
+    // forget everything computed for the last census
+    void Clear();
+
+    /**
+     * Compute function:
+     *
+     * Computes the requested metrics not computed yet for this census in one pass over it.
+     * Calling it again with more needs only adds what is missing (e.g. a row for a generation that stopped the run).
+     *
+     * @param census Census being analyzed (must stay alive until the next Clear).
+     * @param need Metric groups wanted.
+     */
+    void Compute(const Census & census, const size_t need);
+
+    // metric groups computed for this census
+    size_t GetDone() const {return done;}
+
+    ///< data nodes (STATS)
+
+    emp::DataMonitor<double> & PopFit() {return *pop_fit;}
+    emp::DataMonitor<size_t> & PopOpti() {return *pop_opti;}
+    emp::DataMonitor<double> & PntFit() {return *pnt_fit;}
+    emp::DataMonitor<size_t> & PntOpti() {return *pnt_opti;}
+
+    ///< positions
+
+    // first position with the largest aggregate score (BEST)
+    size_t GetElite() const {emp_assert(done & BEST); return elite_pos;}
+    // first position with the largest optimized objective count (BEST)
+    size_t GetOptimized() const {emp_assert(done & BEST); return opti_pos;}
+    // first position of the most common genome, ties go to the genome seen first (STATS)
+    size_t GetCommon() const {emp_assert(done & STATS); return genotypes.GetFirst(genotypes.GetLargest());}
+
+    ///< counts
+
+    // orgs sharing the most common genome (STATS)
+    size_t GetCommonCount() const {emp_assert(done & STATS); return genotypes.GetSize(genotypes.GetLargest());}
+    // objectives optimized by at least one org (UNIQUE)
+    size_t GetUniqueObjective() const {emp_assert(done & UNIQUE); return uni_obj;}
+    // distinct starting positions (STATS)
+    size_t GetUniqueStart() const {emp_assert(done & STATS); return uni_start;}
+    // distinct parents picked by selection (STATS)
+    size_t GetUniqueParent() const {emp_assert(done & STATS); return uni_pnt;}
+    // distinct genomes (STATS)
+    size_t GetUniqueGenotype() const {emp_assert(done & STATS); return genotypes.GetCount();}
+    // distinct score vectors (STATS)
+    size_t GetUniquePhenotype() const {emp_assert(done & STATS); return phenotypes.GetCount();}
+
+  private:
+    // set bit i, true if it was not set before (grows the bitmap as needed)
+    static bool Mark(bits_t & bits, const size_t i);
+
+    // metric groups computed for the current census
+    size_t done = NONE;
+
+    // node to track population fitnesses
+    nodef_t pop_fit;
+    // node to track population opitmized count
+    nodeo_t pop_opti;
+    // node to track parent fitnesses
+    nodef_t pnt_fit;
+    // node to track parent optimized count
+    nodeo_t pnt_opti;
+
+    // elite solution position
+    size_t elite_pos = 0;
+    // optimal solution position
+    size_t opti_pos = 0;
+
+    // population grouped by genome
+    Distinct genotypes;
+    // population grouped by score vector
+    Distinct phenotypes;
+
+    // distinct counts and the bitmaps behind them
+    size_t uni_obj = 0;
+    size_t uni_start = 0;
+    size_t uni_pnt = 0;
+    bits_t obj_bits;
+    bits_t start_bits;
+    bits_t pnt_bits;
+};
+
+void Metrics::Clear()
+{
+  done = NONE;
+  elite_pos = 0; opti_pos = 0;
+  uni_obj = 0; uni_start = 0; uni_pnt = 0;
+}
+
+void Metrics::Compute(const Census & census, const size_t need)
+{
+  // quick checks
+  emp_assert(0 < census.agg.size());
+  emp_assert(census.count.size() == census.agg.size());
+
+  // only what is still missing
+  const size_t todo = need & ~done;
+  if(todo == NONE) {return;}
+
+  const bool best = todo & BEST;
+  const bool unique = todo & UNIQUE;
+  const bool stats = todo & STATS;
+  const size_t N = census.agg.size();
+
+  if(stats)
+  {
+    // quick checks
+    emp_assert(census.parents.size() == N); emp_assert(census.start.size() == N);
+    emp_assert(census.genome.size() == N); emp_assert(census.score.size() == N);
+
+    pop_fit->Reset(); pop_opti->Reset(); pnt_fit->Reset(); pnt_opti->Reset();
+    genotypes.Clear(); phenotypes.Clear();
+    genotypes.Reserve(N); phenotypes.Reserve(N);
+    std::fill(start_bits.begin(), start_bits.end(), 0);
+    std::fill(pnt_bits.begin(), pnt_bits.end(), 0);
+  }
+  if(unique)
+  {
+    // quick checks
+    emp_assert(census.optimal.size() == N);
+
+    std::fill(obj_bits.begin(), obj_bits.end(), 0);
+  }
+
+  // running best values
+  size_t elite = 0; size_t opti = 0; size_t opti_max = 0;
+
+  for(size_t i = 0; i < N; ++i)
+  {
+    if(best)
+    {
+      // same picks as std::max_element and a strict > scan from zero
+      if(census.agg[elite] < census.agg[i]) {elite = i;}
+      if(opti_max < census.count[i]) {opti_max = census.count[i]; opti = i;}
+    }
+
+    if(unique)
+    {
+      const Org::optimal_t & opt = *census.optimal[i];
+      for(size_t o = 0; o < opt.size(); ++o) {if(opt[o] && Mark(obj_bits, o)) {++uni_obj;}}
+    }
+
+    if(stats)
+    {
+      const size_t id = census.parents[i];
+
+      pop_fit->Add(census.agg[i]);
+      pop_opti->Add(census.count[i]);
+      pnt_fit->Add(census.agg[id]);
+      pnt_opti->Add(census.count[id]);
+
+      if(Mark(start_bits, census.start[i])) {++uni_start;}
+      if(Mark(pnt_bits, id)) {++uni_pnt;}
+
+      genotypes.Add(*census.genome[i], i);
+      phenotypes.Add(*census.score[i], i);
+    }
+  }
+
+  if(best) {elite_pos = elite; opti_pos = opti;}
+
+  done |= todo;
+}
+
+bool Metrics::Mark(bits_t & bits, const size_t i)
+{
+  const size_t w = i / 64;
+  if(bits.size() <= w) {bits.resize(w + 1, 0);}
+
+  const word_t bit = word_t(1) << (i % 64);
+  if(bits[w] & bit) {return false;}
+
+  bits[w] |= bit;
+  return true;
+}
+
+#endif
@@ -0,0 +1,266 @@
+/// Mutation operators used on offspring genomes before they are placed in the next generation
+
+#ifndef MUT_H
+#define MUT_H
+
+///< standard headers
+#include <cmath>
+#include <cstdint>
+
+///< empirical headers
+#include "base/Ptr.h"
+#include "base/vector.h"
+#include "tools/Random.h"
+
+///< experiment headers
+#include "org.h"
+#include "stream.h"
+
+class Mutation
+{
+  // object types we are using in this class
+  public:
+    // genome vector type
+    using genome_t = emp::vector<double>;
+    // target vector type
+    using target_t = emp::vector<double>;
+
+
+  public:
+
+    Mutation(emp::Ptr<emp::Random> rng = nullptr) : random(rng) {emp_assert(rng);}
+
+
+    ///< helper functions
+
+    // draw from a counter-based stream instead of the shared random pointer (nullptr to go back)
+    void SetStream(emp::Ptr<Stream> s) {stream = s;}
+
+    /**
+     * Bound function:
+     *
+     * Adds a mutation to a gene while keeping it inside [0, target].
+     * Genes that go over the target wrap back around the target value.
+     * Genes that go into the negatives get clamped at zero.
+     *
+     * @param gene Gene value before mutation.
+     * @param mut Mutation being added.
+     * @param tar Target value for this gene.
+     *
+     * @return New gene value.
+     */
+    double Bound(const double gene, const double mut, const double tar);
+
+    /**
+     * Gap function:
+     *
+     * Number of genes skipped before the next mutated gene.
+     * Drawn from a geometric distribution (number of failures before the first success).
+     *
+     * @param log_q Natural log of (1 - mutation rate), must be negative.
+     *
+     * @return Number of genes to skip.
+     */
+    size_t Gap(const double log_q);
+
+
+    ///< mutation operators
+
+    /**
+     * Per Gene Mutation:
+     *
+     * Flips a biased coin for every gene in the genome and mutates the ones that come up heads.
+     * Cost is proportional to the genome length.
+     *
+     * @param org Offspring being mutated (genome only copied once a mutation lands).
+     * @param target Target vector for the diagnostic.
+     * @param rate Per gene mutation probability.
+     * @param mean Mean of Gaussian mutation distribution.
+     * @param std Standard deviation of Gaussian mutation distribution.
+     *
+     * @return Number of mutations applied.
+     */
+    size_t PerGene(Org & org, const target_t & target, const double rate, const double mean, const double std);
+
+    /**
+     * Skip Mutation:
+     *
+     * Jumps straight from one mutated gene to the next by drawing the gaps between them from a geometric distribution.
+     * Statistically equivalent to PerGene, but cost is proportional to the number of mutations.
+     *
+     * @param org Offspring being mutated (genome only copied once a mutation lands).
+     * @param target Target vector for the diagnostic.
+     * @param rate Per gene mutation probability.
+     * @param mean Mean of Gaussian mutation distribution.
+     * @param std Standard deviation of Gaussian mutation distribution.
+     *
+     * @return Number of mutations applied.
+     */
+    size_t Skip(Org & org, const target_t & target, const double rate, const double mean, const double std);
+
+  private:
+
+    // draws from the stream if we have one, otherwise the random pointer
+    bool P(const double p) {return (stream) ? stream->P(p) : random->P(p);}
+    double GetDouble() {return (stream) ? stream->GetDouble() : random->GetDouble();}
+    double GetRandNormal(const double mean, const double std) {return (stream) ? stream->GetRandNormal(mean, std) : random->GetRandNormal(mean, std);}
+
+  private:
+
+    // random pointer from world.h
+    emp::Ptr<emp::Random> random;
+    // counter-based stream from world.h (optional)
+    emp::Ptr<Stream> stream = nullptr;
+
+    // bulk draws with a stream: a coin per gene (PerGene), the genes that get mutated and their mutations
+    emp::vector<double> coins;
+    emp::vector<size_t> hits;
+    emp::vector<double> muts;
+};
+
+///< helper functions
+
+double Mutation::Bound(const double gene, const double mut, const double tar)
+{
+  // mutation puts objective above target
+  if(tar < gene + mut)
+  {
+    // we wrap it back around target value
+    return tar - (gene + mut - tar);
+  }
+  // mutation puts objective in the negatives
+  else if(gene + mut < 0.0)
+  {
+    return 0.0;
+  }
+
+  // else we can simply add mutation
+  return gene + mut;
+}
+
+size_t Mutation::Gap(const double log_q)
+{
+  // quick checks
+  emp_assert(log_q < 0.0);
+
+  // 1 - [0,1) keeps us away from log(0)
+  const double gap = std::floor(std::log(1.0 - GetDouble()) / log_q);
+
+  // very small rates can produce gaps past anything we can index
+  if(gap >= static_cast<double>(SIZE_MAX)) {return SIZE_MAX;}
+
+  return static_cast<size_t>(gap);
+}
+
+
+///< mutation operators
+
+size_t Mutation::PerGene(Org & org, const target_t & target, const double rate, const double mean, const double std)
+{
+  // quick checks
+  emp_assert(org.GetGenome().size() == target.size());
+  emp_assert(0.0 <= rate); emp_assert(rate <= 1.0);
+
+  // streams hand out every coin in one bulk fill, then exactly the mutations they call for in another
+  // (same draws as flipping and mutating gene by gene, see Stream's bulk draws)
+  if(stream)
+  {
+    coins.resize(target.size());
+    stream->GetDoubles(coins.data(), coins.size());
+
+    hits.clear();
+    for(size_t i = 0; i < coins.size(); ++i) {if(coins[i] < rate) {hits.push_back(i);}}
+    if(hits.empty()) {return 0;}
+
+    muts.resize(hits.size());
+    stream->GetRandNormals(muts.data(), muts.size(), mean, std);
+
+    // offspring only gets its own copy of the genome once a mutation lands
+    genome_t & genome = org.EditGenome();
+    for(size_t k = 0; k < hits.size(); ++k) {genome[hits[k]] = Bound(genome[hits[k]], muts[k], target[hits[k]]);}
+
+    return hits.size();
+  }
+
+  // number of mutations
+  size_t mcnt = 0;
+
+  // the shared random pointer flips and mutates gene by gene: filling a buffer ahead of use would shift every
+  // later draw of the run (selection, the next generations), so existing seeds would no longer reproduce their data
+  for(size_t i = 0; i < target.size(); ++i)
+  {
+    // if we do a mutation at this objective
+    if(P(rate))
+    {
+      // offspring only gets its own copy of the genome once a mutation lands
+      genome_t & genome = org.EditGenome();
+      const double mut = GetRandNormal(mean, std);
+
+      genome[i] = Bound(genome[i], mut, target[i]);
+      ++mcnt;
+    }
+  }
+
+  return mcnt;
+}
+
+size_t Mutation::Skip(Org & org, const target_t & target, const double rate, const double mean, const double std)
+{
+  // quick checks
+  emp_assert(org.GetGenome().size() == target.size());
+  emp_assert(0.0 <= rate); emp_assert(rate <= 1.0);
+
+  // edge cases where there is nothing to skip
+  if(rate <= 0.0) {return 0;}
+  if(1.0 <= rate) {return PerGene(org, target, rate, mean, std);}
+
+  const double log_q = std::log1p(-rate);
+
+  // streams walk the gaps first, then hand out exactly the mutations they call for in one bulk fill
+  // (normals have their own sub-stream, so these are the same draws as mutating gene by gene)
+  if(stream)
+  {
+    hits.clear();
+    for(size_t i = Gap(log_q); i < target.size(); ++i)
+    {
+      hits.push_back(i);
+
+      const size_t gap = Gap(log_q);
+      if(target.size() - i <= gap) {break;}
+      i += gap;
+    }
+    if(hits.empty()) {return 0;}
+
+    muts.resize(hits.size());
+    stream->GetRandNormals(muts.data(), muts.size(), mean, std);
+
+    // offspring only gets its own copy of the genome once a mutation lands
+    genome_t & genome = org.EditGenome();
+    for(size_t k = 0; k < hits.size(); ++k) {genome[hits[k]] = Bound(genome[hits[k]], muts[k], target[hits[k]]);}
+
+    return hits.size();
+  }
+
+  // number of mutations
+  size_t mcnt = 0;
+
+  // walk through the mutated genes only (one draw at a time from the shared random pointer, see PerGene)
+  for(size_t i = Gap(log_q); i < target.size(); ++i)
+  {
+    // offspring only gets its own copy of the genome once a mutation lands
+    genome_t & genome = org.EditGenome();
+    const double mut = GetRandNormal(mean, std);
+
+    genome[i] = Bound(genome[i], mut, target[i]);
+    ++mcnt;
+
+    // jump to the next mutated gene
+    const size_t gap = Gap(log_q);
+    if(target.size() - i <= gap) {break;}
+    i += gap;
+  }
+
+  return mcnt;
+}
+
+#endif
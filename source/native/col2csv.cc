@@ -0,0 +1,86 @@
+// Converts a binary columnar data file (data.col, DATA_FORMAT 1 or 2) back into the data.csv it stands for.
+//   ./col2csv data.col [data.csv]             (writes to stdout without an output path)
+//   ./col2csv --info data.col                 (columns, blocks and rows)
+//   ./col2csv --column gen data.col [gen.csv] (one column only, the rest of the file is never read)
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../columns.h"
+
+// write one column with its key as the header
+bool WriteColumn(ColumnReader & reader, const size_t c, std::ostream & os)
+{
+  os << reader.GetKeys()[c] << "\n";
+
+  emp::vector<uint64_t> vals;
+  for(size_t b = 0; b < reader.GetBlockCnt(); ++b)
+  {
+    if(!reader.ReadColumn(b, c, vals)) {return false;}
+
+    for(const uint64_t v : vals)
+    {
+      if(reader.GetTypes()[c] == col::F64) {os << col::Double(v);}
+      else {os << static_cast<size_t>(v);}
+      os << "\n";
+    }
+  }
+
+  return static_cast<bool>(os);
+}
+
+int main(int argc, char* argv[])
+{
+  const bool info = 1 < argc && std::string(argv[1]) == "--info";
+  const bool column = 2 < argc && std::string(argv[1]) == "--column";
+  const int first = info ? 2 : (column ? 3 : 1);
+
+  if(argc <= first)
+  {
+    std::cerr << "usage: " << argv[0] << " [--info | --column key] data.col [data.csv]" << std::endl;
+    return 1;
+  }
+
+  ColumnReader reader;
+  if(!reader.Open(argv[first])) {return 1;}
+
+  if(info)
+  {
+    std::cout << "columns: " << reader.GetColumnCnt() << std::endl;
+    for(size_t c = 0; c < reader.GetColumnCnt(); ++c)
+    {
+      std::cout << "  " << reader.GetKeys()[c] << " (" << (reader.GetTypes()[c] == col::F64 ? "f64" : "u64") << "): " << reader.GetDescs()[c] << std::endl;
+    }
+    std::cout << "blocks: " << reader.GetBlockCnt() << std::endl;
+    std::cout << "rows: " << reader.GetRowCnt() << std::endl;
+    std::cout << "footer: " << (reader.GetIndexed() ? "yes" : "no (run did not finish)") << std::endl;
+    return 0;
+  }
+
+  size_t c = 0;
+  if(column)
+  {
+    while(c < reader.GetColumnCnt() && reader.GetKeys()[c] != argv[2]) {++c;}
+    if(c == reader.GetColumnCnt())
+    {
+      std::cerr << "ERROR: " << argv[first] << " HAS NO COLUMN " << argv[2] << std::endl;
+      return 1;
+    }
+  }
+
+  if(first + 1 < argc)
+  {
+    std::ofstream os(argv[first + 1]);
+    if(!os)
+    {
+      std::cerr << "ERROR: COULD NOT OPEN " << argv[first + 1] << std::endl;
+      return 1;
+    }
+    if(column) {return WriteColumn(reader, c, os) ? 0 : 1;}
+    return reader.WriteCSV(os) ? 0 : 1;
+  }
+
+  if(column) {return WriteColumn(reader, c, std::cout) ? 0 : 1;}
+  return reader.WriteCSV(std::cout) ? 0 : 1;
+}
@@ -1,6 +1,9 @@
 // This is the main function for the NATIVE version of this project.
 
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <thread>
 
 #include "base/vector.h"
 #include "config/command_line.h"
@@ -9,11 +12,36 @@
 #include "../config.h"
 #include "../world.h"
 #include "../org.h"
+#include "../checkpoint.h"
+#include "../island.h"
+#include "../island_mpi.h"
+#include "../batch.h"
 
 // Hello world
 
 int main(int argc, char* argv[])
 {
+#ifdef DIA_MPI
+  MPI_Init(&argc, &argv);
+  // finalize on every way out (including bad configs)
+  std::atexit([]() {MPI_Finalize();});
+#endif
+
+  // batch mode flags (--batch manifest [--jobs N]) and --resume checkpoint are pulled out before the config flags are read
+  std::string manifest = "";
+  std::string resume = "";
+  size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+  int keep = 1;
+  for(int i = 1; i < argc; ++i)
+  {
+    const std::string flag = argv[i];
+    if(flag == "--batch" && i + 1 < argc) {manifest = argv[++i];}
+    else if(flag == "--jobs" && i + 1 < argc) {jobs = std::max(1, std::stoi(argv[++i]));}
+    else if(flag == "--resume" && i + 1 < argc) {resume = argv[++i];}
+    else {argv[keep++] = argv[i];}
+  }
+  argc = keep;
+
   DiaConfig config;
   config.Read("Dia.cfg", false);
   auto args = emp::cl::ArgManager(argc, argv);
@@ -28,9 +56,56 @@ int main(int argc, char* argv[])
             << std::endl;
 
 
-  DiagWorld world(config);
+  // every manifest line is its own run, the command line only sets the defaults they start from
+  if(manifest != "")
+  {
+    Batch batch(config);
+    if(!batch.Load(manifest)) {return 1;}
+    Termination::CatchSignals();
+    batch.Run(jobs);
+    return 0;
+  }
+
+#ifdef DIA_MPI
+  // every rank runs one island, a SIGINT/SIGTERM on any rank stops them all at the same generation
+  MpiIslandModel model(config);
+  Termination::CatchSignals();
+  model.Run();
+  return 0;
+#endif
+
+  // islands run their own loops, a SIGINT/SIGTERM stops them all at the same generation
+  if(1 < config.ISLANDS())
+  {
+    IslandModel model(config);
+    Termination::CatchSignals();
+    model.Run();
+    return 0;
+  }
+
+  // carry on from a checkpoint made with the same settings
+  emp::Ptr<Checkpoint> ckpt = nullptr;
+  if(resume != "")
+  {
+    ckpt = emp::NewPtr<Checkpoint>();
+    std::string err;
+    if(!ckpt->Read(resume)) {ckpt.Delete(); return 1;}
+    if(!ckpt->Check(config, err))
+    {
+      std::cerr << "ERROR: CANNOT RESUME FROM " << resume << ": " << err << std::endl;
+      ckpt.Delete();
+      return 1;
+    }
+  }
+
+  DiagWorld world(config, ckpt);
+  if(ckpt) {ckpt.Delete();}
+
+  // SIGINT/SIGTERM (e.g. slurm running out of time) stop the run after the current generation, with its data flushed
+  Termination::CatchSignals();
 
-  for (size_t ud = 0; ud <= config.MAX_GENS(); ud++)
+  // run until MAX_GENS, a termination criterion fires, or a signal arrives
+  for (size_t ud = world.GetUpdate(); ud <= config.MAX_GENS() && !world.Stopped(); ud++)
   {
     world.Update();
   }
@@ -0,0 +1,77 @@
+// Converts a population snapshot (pop_<gen>.snap, POP_SNAP 1) into csv, one row per solution.
+//   ./snap2csv pop_1000.snap [pop_1000.csv]   (writes to stdout without an output path)
+//   ./snap2csv --info pop_1000.snap           (generation, run and sizes)
+
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "../snapshot.h"
+
+// id, clone, start, then every genome value, score and optimal bit
+void WriteCSV(const SnapshotReader & reader, std::ostream & os)
+{
+  const size_t obj = reader.GetObjectiveCnt();
+
+  os << "id,clone,start";
+  for(size_t j = 0; j < obj; ++j) {os << ",genome_" << j;}
+  for(size_t j = 0; j < obj; ++j) {os << ",score_" << j;}
+  for(size_t j = 0; j < obj; ++j) {os << ",optimal_" << j;}
+  os << "\n";
+
+  os.precision(std::numeric_limits<double>::max_digits10);
+  for(size_t i = 0; i < reader.GetPopSize(); ++i)
+  {
+    os << i << "," << reader.Clone(i) << "," << reader.Start(i);
+    const double * genome = reader.Genome(i);
+    const double * score = reader.Score(i);
+    for(size_t j = 0; j < obj; ++j) {os << "," << genome[j];}
+    for(size_t j = 0; j < obj; ++j) {os << "," << score[j];}
+    for(size_t j = 0; j < obj; ++j) {os << "," << reader.Optimal(i, j);}
+    os << "\n";
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const bool info = 1 < argc && std::string(argv[1]) == "--info";
+  const int first = info ? 2 : 1;
+
+  if(argc <= first)
+  {
+    std::cerr << "usage: " << argv[0] << " [--info] pop_<gen>.snap [pop_<gen>.csv]" << std::endl;
+    return 1;
+  }
+
+  SnapshotReader reader;
+  if(!reader.Open(argv[first])) {return 1;}
+
+  if(info)
+  {
+    const snap::Header & head = reader.GetHeader();
+    std::cout << "generation: " << head.gen << std::endl;
+    std::cout << "seed: " << head.seed << std::endl;
+    std::cout << "selection: " << head.selection << std::endl;
+    std::cout << "diagnostic: " << head.diagnostic << std::endl;
+    std::cout << "solutions: " << head.pop_size << std::endl;
+    std::cout << "objectives: " << head.objective_cnt << std::endl;
+    std::cout << "bytes: " << head.size << std::endl;
+    return 0;
+  }
+
+  if(first + 1 < argc)
+  {
+    std::ofstream os(argv[first + 1]);
+    if(!os)
+    {
+      std::cerr << "ERROR: COULD NOT OPEN " << argv[first + 1] << std::endl;
+      return 1;
+    }
+    WriteCSV(reader, os);
+    return os ? 0 : 1;
+  }
+
+  WriteCSV(reader, std::cout);
+  return std::cout ? 0 : 1;
+}
@@ -5,6 +5,8 @@
 
 ///< standard headers
 #include <algorithm>
+#include <memory>
+#include <numeric>
 
 ///< empirical headers
 #include "base/vector.h"
@@ -24,29 +26,33 @@ class Org
     // optimal gene vector type
     using optimal_t = emp::vector<bool>;
 
+    // shared storage types (copy-on-write between parents and offspring)
+    using genome_ptr_t = std::shared_ptr<genome_t>;
+    using score_ptr_t = std::shared_ptr<score_t>;
+    using optimal_ptr_t = std::shared_ptr<optimal_t>;
+
   public:
     // for initial population
     Org(size_t _m)
     {
       // make sure nun weird is happening
-      emp_assert(genome.size() == 0); emp_assert(M == 0);
+      emp_assert(!genome); emp_assert(M == 0);
       M = _m;
       start_pos = _m;
-      genome.resize(_m, START_DB);
+      genome = std::make_shared<genome_t>(_m, START_DB);
     }
 
     // every org after starting generation
     Org(genome_t _g)
     {
       // make sure we aren't seeing anything weird
-      emp_assert(genome.size() == 0); emp_assert(M == 0);
+      emp_assert(!genome); emp_assert(M == 0);
       M = _g.size();
       start_pos = _g.size();
-      genome.resize(M);
-      std::copy(_g.begin(), _g.end(), genome.begin());
+      genome = std::make_shared<genome_t>(_g.begin(), _g.end());
     }
 
-    // ask Charles
+    // copies share genome and phenotype storage until one of them writes to it
     Org(const Org &) = default;
     Org(Org &&) = default;
     ~Org() { ; }
@@ -55,18 +61,22 @@ class Org
 
     ///< getters
 
-    // const + reference to
-    const genome_t & GetGenome() const {emp_assert(0 < genome.size()); return genome;}
-    const score_t & GetScore() const {emp_assert(scored); return score;}
-    const optimal_t & GetOptimal() const {emp_assert(opti); return optimal;}
-    // reference to
-    genome_t & GetGenome() {emp_assert(0 < genome.size()); return genome;}
-    score_t & GetScore() {emp_assert(scored); return score;}
-    optimal_t & GetOptimal() {emp_assert(opti); return optimal;}
+    // const + reference to (storage may be shared with other orgs, so no writes through these)
+    const genome_t & GetGenome() const {emp_assert(genome); emp_assert(0 < genome->size()); return *genome;}
+    const score_t & GetScore() const {emp_assert(scored); return *score;}
+    const optimal_t & GetOptimal() const {emp_assert(opti); return *optimal;}
+    // writable reference to genome (copy is made first if storage is shared)
+    genome_t & EditGenome();
+    // read only handles to shared storage (keeps it alive without a copy, e.g. for data snapshots)
+    std::shared_ptr<const genome_t> ShareGenome() const {emp_assert(genome); return genome;}
+    std::shared_ptr<const score_t> ShareScore() const {emp_assert(scored); return score;}
+    std::shared_ptr<const optimal_t> ShareOptimal() const {emp_assert(opti); return optimal;}
+    // is genome storage shared with another org?
+    bool SharedGenome() const {emp_assert(genome); return 1 < genome.use_count();}
     // get const aggregate fitness
     double GetAggregate() {emp_assert(aggregated); return agg_score;}
     // get clone bool
-    bool GetClone() const {emp_assert(0 < genome.size()); return clone;}
+    bool GetClone() const {emp_assert(genome); return clone;}
     // get optimal
     size_t GetCount() const {emp_assert(counted); return count;}
     // get gene count
@@ -90,20 +100,18 @@ class Org
     void SetScore(const score_t & s_)
     {
       // make sure that score vector hasn't been set before.
-      emp_assert(!scored); emp_assert(s_.size() == M); emp_assert(score.size() == 0); emp_assert(0 < M);
+      emp_assert(!scored); emp_assert(s_.size() == M); emp_assert(!score); emp_assert(0 < M);
       scored = true;
-      score.resize(s_.size());
-      std::copy(s_.begin(), s_.end(), score.begin());
+      score = std::make_shared<score_t>(s_.begin(), s_.end());
     }
 
     // set the optimal gene vector (recieved from problem.h in world.h or inherited from parent)
     void SetOptimal(const optimal_t & o_)
     {
       // make sure that optimal gene vector hasn't been set before.
-      emp_assert(!opti); emp_assert(o_.size() == M); emp_assert(optimal.size() == 0); emp_assert(0 < M);
+      emp_assert(!opti); emp_assert(o_.size() == M); emp_assert(!optimal); emp_assert(0 < M);
       opti = true;
-      optimal.resize(o_.size());
-      std::copy(o_.begin(), o_.end(), optimal.begin());
+      optimal = std::make_shared<optimal_t>(o_.begin(), o_.end());
     }
 
     // set the optimal gene count (called from world.h or inherited from parent)
@@ -190,20 +198,22 @@ class Org
      * Me Clone function:
      *
      * Will set the clone variable to true.
+     * An offspring copied from its parent already shares the parent's phenotype,
+     * so nothing else needs to be inherited.
     */
-    void MeClone() {emp_assert(0 < M); emp_assert(!clone); clone = true;}
+    void MeClone() {emp_assert(0 < M); clone = true;}
 
   private:
-    // organism genome vector
-    genome_t genome;
+    // organism genome vector (shared with clones)
+    genome_ptr_t genome;
 
-    // organism score vector
-    score_t score;
+    // organism score vector (shared with clones)
+    score_ptr_t score;
     // score vector set?
     bool scored = false;
 
-    // organims gene optimal vector
-    optimal_t optimal;
+    // organims gene optimal vector (shared with clones)
+    optimal_ptr_t optimal;
     // gene optimal vector calculated?
     bool opti = false;
 
@@ -234,9 +244,20 @@ bool Org::OptimizedAt(const size_t obj)
 {
   // quick checks
   emp_assert(0 <= obj); emp_assert(obj < M);
-  emp_assert(0 < optimal.size()); emp_assert(M == optimal.size());
+  emp_assert(optimal); emp_assert(M == optimal->size());
+
+  return (*optimal)[obj];
+}
+
+Org::genome_t & Org::EditGenome()
+{
+  // quick checks
+  emp_assert(genome); emp_assert(0 < M);
+
+  // somebody else is looking at this genome, so we get our own copy first
+  if(SharedGenome()) {genome = std::make_shared<genome_t>(*genome);}
 
-  return optimal[obj];
+  return *genome;
 }
 
 ///< functions to calculate scores and related data
@@ -245,10 +266,10 @@ double Org::AggregateScore()
 {
   //quick checks
   emp_assert(!aggregated); emp_assert(0 < M);
-  emp_assert(score.size() == M, score.size());
+  emp_assert(score); emp_assert(score->size() == M, score->size());
 
   // calculate the aggregate score and set it
-  SetAggregate(std::accumulate(score.begin(), score.end(), START_DB));
+  SetAggregate(std::accumulate(score->begin(), score->end(), START_DB));
 
   return agg_score;
 }
@@ -257,10 +278,10 @@ size_t Org::CountOptimized()
 {
   //quick checks
   emp_assert(!counted); emp_assert(0 < M); emp_assert(opti);
-  emp_assert(optimal.size() == M, optimal.size());
+  emp_assert(optimal); emp_assert(optimal->size() == M, optimal->size());
 
   // calculate total optimal genes and set it
-  SetCount(std::accumulate(optimal.begin(), optimal.end(), START_ST));
+  SetCount(std::accumulate(optimal->begin(), optimal->end(), START_ST));
 
   return count;
 }
@@ -269,11 +290,11 @@ size_t Org::StartPosition()
 {
   // quick checks
   emp_assert(!start); emp_assert(0 < M);
-  emp_assert(score.size() == M);
+  emp_assert(score); emp_assert(score->size() == M);
 
   // find max value position
-  auto opti_it = std::max_element(score.begin(), score.end());
-  start_pos = std::distance(score.begin(), opti_it);
+  auto opti_it = std::max_element(score->begin(), score->end());
+  start_pos = std::distance(score->begin(), opti_it);
 
   return start_pos;
 }
@@ -284,14 +305,14 @@ size_t Org::StartPosition()
 void Org::Reset()
 {
   // quick checks
-  emp_assert(0 < M); emp_assert(0 < genome.size());
+  emp_assert(0 < M); emp_assert(genome);
 
-  // reset score vector stuff
-  score.clear();
+  // reset score vector stuff (drops our share of the parent's phenotype)
+  score.reset();
   scored = false;
 
   // reset optimal gene vector stuff
-  optimal.clear();
+  optimal.reset();
   opti = false;
 
   // reset optimal gene count stuff
@@ -303,7 +324,7 @@ void Org::Reset()
   aggregated = false;
 
   // reset starting position info
-  start_pos = genome.size();
+  start_pos = genome->size();
   start = false;
 
   // reset clone var
@@ -313,7 +334,7 @@ void Org::Reset()
 void Org::Inherit(const score_t & s, const optimal_t & o, const size_t c, const double a, const size_t st)
 {
   // quick checks
-  emp_assert(0 < M); emp_assert(0 < genome.size()); emp_assert(clone);
+  emp_assert(0 < M); emp_assert(genome); emp_assert(clone);
 
   // copy everything into offspring solution
   SetScore(s);
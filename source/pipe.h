@@ -0,0 +1,117 @@
+/// Single background thread that runs jobs one at a time, in the order they are handed over
+/// Used to take work off the critical path of the generation loop
+
+#ifndef PIPE_H
+#define PIPE_H
+
+///< standard headers
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class Pipe
+{
+  // object types we are using in this class
+  public:
+    // work handed to the background thread
+    using job_t = std::function<void()>;
+
+
+  public:
+
+    Pipe() : thread(&Pipe::Work, this) {;}
+
+    // finishes the job in flight before joining
+    ~Pipe();
+
+    ///< helper functions
+
+    /**
+     * Submit function:
+     *
+     * Waits for the job in flight (if any) to finish, then hands a new job to the background thread.
+     * At most one job is ever in flight, so jobs run in the order they are submitted.
+     *
+     * @param fun Job to run in the background.
+     */
+    void Submit(job_t fun);
+
+    // block until the background thread is idle
+    void Wait();
+
+  private:
+    // loop run by the background thread
+    void Work();
+
+  private:
+    // guards everything below
+    std::mutex lock;
+    // wakes the background thread up when a job is handed over
+    std::condition_variable ready;
+    // wakes waiting threads up when a job is finished
+    std::condition_variable idle;
+
+    // job in flight
+    job_t job;
+    // is a job in flight?
+    bool busy = false;
+    // tells the background thread to exit
+    bool stop = false;
+
+    // background thread (started last, once everything above exists)
+    std::thread thread;
+};
+
+Pipe::~Pipe()
+{
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    idle.wait(guard, [this]() {return !busy;});
+    stop = true;
+  }
+  ready.notify_one();
+
+  thread.join();
+}
+
+void Pipe::Submit(job_t fun)
+{
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    idle.wait(guard, [this]() {return !busy;});
+    job = std::move(fun);
+    busy = true;
+  }
+  ready.notify_one();
+}
+
+void Pipe::Wait()
+{
+  std::unique_lock<std::mutex> guard(lock);
+  idle.wait(guard, [this]() {return !busy;});
+}
+
+void Pipe::Work()
+{
+  while(true)
+  {
+    job_t fun;
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      ready.wait(guard, [this]() {return stop || busy;});
+      if(stop) {return;}
+      fun = std::move(job);
+    }
+
+    fun();
+
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      busy = false;
+    }
+    idle.notify_all();
+  }
+}
+
+#endif
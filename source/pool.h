@@ -0,0 +1,262 @@
+/// Worker threads for splitting independent work across cores
+/// Pool splits per-slot work into fixed chunks, TaskPool balances uneven tasks by work stealing
+
+#ifndef POOL_H
+#define POOL_H
+
+///< standard headers
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///< empirical headers
+#include "base/assert.h"
+
+/// Fixed pool for per-slot work
+/// The calling thread always takes the first chunk, so a pool of size 1 never starts a thread
+class Pool
+{
+  // object types we are using in this class
+  public:
+    // work done by one worker on slots [begin,end)
+    using job_t = std::function<void(const size_t begin, const size_t end, const size_t worker)>;
+
+
+  public:
+
+    Pool(const size_t threads = 1);
+
+    ~Pool();
+
+    ///< helper functions
+
+    // number of workers (including the calling thread)
+    size_t GetSize() const {return size;}
+
+    // first slot of a worker's chunk when splitting n slots
+    size_t ChunkStart(const size_t n, const size_t worker) const {return (n * worker) / size;}
+
+    /**
+     * ParallelFor function:
+     *
+     * Splits slots [0,n) into one contiguous chunk per worker and runs the job on every chunk.
+     * Chunks only depend on n and the pool size, and the call returns once every chunk is done.
+     *
+     * @param n Number of slots.
+     * @param job Work done on a chunk of slots.
+     */
+    void ParallelFor(const size_t n, const job_t & job);
+
+  private:
+    // loop run by every started thread
+    void Work(const size_t worker);
+
+  private:
+    // number of workers (including the calling thread)
+    size_t size;
+    // started threads (worker ids 1 and up)
+    std::vector<std::thread> threads;
+
+    // guards everything below
+    std::mutex lock;
+    // wakes threads up when a new round starts
+    std::condition_variable start;
+    // wakes the calling thread up when a round finishes
+    std::condition_variable done;
+
+    // job and slot count for the current round
+    const job_t * job = nullptr;
+    size_t slots = 0;
+    // current round and started threads still busy with it
+    size_t round = 0;
+    size_t busy = 0;
+    // tells threads to exit
+    bool stop = false;
+};
+
+Pool::Pool(const size_t threads_cnt) : size(threads_cnt)
+{
+  // quick checks
+  emp_assert(0 < size);
+
+  for(size_t w = 1; w < size; ++w) {threads.emplace_back(&Pool::Work, this, w);}
+}
+
+Pool::~Pool()
+{
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stop = true;
+  }
+  start.notify_all();
+
+  for(auto & t : threads) {t.join();}
+}
+
+void Pool::ParallelFor(const size_t n, const job_t & fun)
+{
+  // nothing to split, so skip the wake ups
+  if(size == 1)
+  {
+    if(0 < n) {fun(0, n, 0);}
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    job = &fun; slots = n;
+    busy = size - 1;
+    ++round;
+  }
+  start.notify_all();
+
+  // calling thread does the first chunk
+  const size_t end = ChunkStart(n, 1);
+  if(0 < end) {fun(0, end, 0);}
+
+  // wait for everyone else
+  std::unique_lock<std::mutex> guard(lock);
+  done.wait(guard, [this]() {return busy == 0;});
+  job = nullptr;
+}
+
+void Pool::Work(const size_t worker)
+{
+  size_t seen = 0;
+
+  while(true)
+  {
+    const job_t * fun = nullptr; size_t n = 0;
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      start.wait(guard, [this, seen]() {return stop || round != seen;});
+      if(stop) {return;}
+
+      seen = round;
+      fun = job; n = slots;
+    }
+
+    const size_t begin = ChunkStart(n, worker);
+    const size_t end = ChunkStart(n, worker + 1);
+    if(begin < end) {(*fun)(begin, end, worker);}
+
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      --busy;
+    }
+    done.notify_one();
+  }
+}
+
+/// Work-stealing pool for coarse tasks of uneven length (e.g. whole runs)
+/// Every worker drains its own deque from the front and steals from the back of the others once it runs dry
+class TaskPool
+{
+  // object types we are using in this class
+  public:
+    // work done by one task
+    using task_t = std::function<void()>;
+
+
+  public:
+
+    TaskPool(const size_t threads = 1);
+
+    ///< helper functions
+
+    // number of workers (including the calling thread)
+    size_t GetSize() const {return queues.size();}
+
+    // queue a task (dealt round robin across the workers)
+    void Submit(task_t task);
+
+    // run every queued task on all workers, returns once they are all done
+    void Run();
+
+  private:
+    // next task for a worker, false once every deque is empty
+    bool Next(const size_t worker, task_t & task);
+
+  private:
+    // deque of tasks and its lock
+    struct queue_t
+    {
+      std::mutex lock;
+      std::deque<task_t> tasks;
+    };
+
+    // one deque per worker
+    std::vector<std::unique_ptr<queue_t>> queues;
+    // worker the next submitted task goes to
+    size_t next = 0;
+};
+
+TaskPool::TaskPool(const size_t threads)
+{
+  // quick checks
+  emp_assert(0 < threads);
+
+  for(size_t w = 0; w < threads; ++w) {queues.emplace_back(new queue_t());}
+}
+
+void TaskPool::Submit(task_t task)
+{
+  queue_t & q = *queues[next];
+  next = (next + 1) % queues.size();
+
+  std::lock_guard<std::mutex> guard(q.lock);
+  q.tasks.push_back(std::move(task));
+}
+
+void TaskPool::Run()
+{
+  auto work = [this](const size_t worker)
+  {
+    task_t task;
+    while(Next(worker, task)) {task();}
+  };
+
+  // tasks are never added while running, so a worker that finds nothing anywhere is done
+  std::vector<std::thread> threads;
+  for(size_t w = 1; w < GetSize(); ++w) {threads.emplace_back(work, w);}
+  work(0);
+
+  for(auto & t : threads) {t.join();}
+}
+
+bool TaskPool::Next(const size_t worker, task_t & task)
+{
+  // own deque first (front)
+  {
+    queue_t & q = *queues[worker];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if(!q.tasks.empty())
+    {
+      task = std::move(q.tasks.front());
+      q.tasks.pop_front();
+      return true;
+    }
+  }
+
+  // then steal from everyone else (back)
+  for(size_t i = 1; i < GetSize(); ++i)
+  {
+    queue_t & q = *queues[(worker + i) % GetSize()];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if(!q.tasks.empty())
+    {
+      task = std::move(q.tasks.back());
+      q.tasks.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#endif
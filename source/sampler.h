@@ -0,0 +1,124 @@
+/// Which generations get a data row (DATA_SAMPLING): every DATA_INTERVAL, log spaced, dense early and sparse late,
+/// or whenever the best optimized count or pop_uni_obj moves
+/// Generations without a row skip the row metrics, so sparse sampling saves their cost as well as the output
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+///< standard headers
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+///< experiment headers
+#include "config.h"
+
+class Sampler
+{
+  // object types we are using in this class
+  public:
+    // sampling policies
+    enum Policy : size_t
+    {
+      FIXED = 0,   // every DATA_INTERVAL generations
+      LOG,         // DATA_PER_DECADE generations per power of ten (every generation early on)
+      DENSE,       // every DATA_INTERVAL up to DATA_DENSE_GENS, then every DATA_SPARSE_INTERVAL
+      EVENTS,      // every DATA_SPARSE_INTERVAL, and whenever the best optimized count or pop_uni_obj changes
+      POLICIES
+    };
+
+
+  public:
+
+    Sampler(const DiaConfig & config)
+      : policy(config.DATA_SAMPLING()), interval(std::max<size_t>(1, config.DATA_INTERVAL())), per_decade(std::max<size_t>(1, config.DATA_PER_DECADE())),
+        dense_gens(config.DATA_DENSE_GENS()), sparse(std::max<size_t>(1, config.DATA_SPARSE_INTERVAL())), last(config.MAX_GENS()) {;}
+
+    ///< helper functions
+
+    // is a known policy with usable intervals configured? (err says what is wrong if not, intervals of 0 are used as 1)
+    static bool Check(const DiaConfig & config, std::string & err);
+
+    // does generation gen get a row by the schedule alone (the first and last generation always do)?
+    bool Scheduled(const size_t gen) const;
+
+    // does the policy also need the best optimized count and pop_uni_obj of every generation?
+    bool WatchesEvents() const {return policy == EVENTS;}
+
+    // did the best optimized count or pop_uni_obj change since the last call? (the first call always counts)
+    bool Changed(const size_t opt_cnt, const size_t uni_obj);
+
+    // state of the event watch, for checkpoints (seen is false before the first call)
+    void GetState(bool & _seen, uint64_t & _opt_cnt, uint64_t & _uni_obj) const {_seen = seen; _opt_cnt = opt_cnt; _uni_obj = uni_obj;}
+    void SetState(const bool _seen, const uint64_t _opt_cnt, const uint64_t _uni_obj) {seen = _seen; opt_cnt = _opt_cnt; uni_obj = _uni_obj;}
+
+    // short description of the policy for setup messages
+    std::string Describe() const;
+
+  private:
+    size_t policy;
+    size_t interval;
+    size_t per_decade;
+    size_t dense_gens;
+    size_t sparse;
+    size_t last;
+
+    // event watch
+    bool seen = false;
+    uint64_t opt_cnt = 0;
+    uint64_t uni_obj = 0;
+};
+
+bool Sampler::Check(const DiaConfig & config, std::string & err)
+{
+  const size_t policy = config.DATA_SAMPLING();
+  if(POLICIES <= policy) {err = "unknown DATA_SAMPLING " + std::to_string(policy) + ", sampling every DATA_INTERVAL"; return false;}
+  if((policy == FIXED || policy == DENSE) && config.DATA_INTERVAL() == 0) {err = "DATA_INTERVAL 0 is used as 1"; return false;}
+  if(policy == LOG && config.DATA_PER_DECADE() == 0) {err = "DATA_PER_DECADE 0 is used as 1"; return false;}
+  if((policy == DENSE || policy == EVENTS) && config.DATA_SPARSE_INTERVAL() == 0) {err = "DATA_SPARSE_INTERVAL 0 is used as 1"; return false;}
+  return true;
+}
+
+bool Sampler::Scheduled(const size_t gen) const
+{
+  if(gen == 0 || gen == last) {return true;}
+
+  switch(policy)
+  {
+    case LOG:
+      // a row whenever gen moves into the next of per_decade log spaced buckets
+      return std::floor(per_decade * std::log10(static_cast<double>(gen))) != std::floor(per_decade * std::log10(static_cast<double>(gen - 1)));
+
+    case DENSE:
+      return (gen <= dense_gens) ? !(gen % interval) : !(gen % sparse);
+
+    case EVENTS:
+      return !(gen % sparse);
+
+    default:
+      return !(gen % interval);
+  }
+}
+
+bool Sampler::Changed(const size_t _opt_cnt, const size_t _uni_obj)
+{
+  const bool changed = !seen || opt_cnt != _opt_cnt || uni_obj != _uni_obj;
+  seen = true;
+  opt_cnt = _opt_cnt;
+  uni_obj = _uni_obj;
+  return changed;
+}
+
+std::string Sampler::Describe() const
+{
+  switch(policy)
+  {
+    case LOG: return std::to_string(per_decade) + " rows per power of ten generations";
+    case DENSE: return "every " + std::to_string(interval) + " generations up to " + std::to_string(dense_gens) + ", then every " + std::to_string(sparse);
+    case EVENTS: return "every " + std::to_string(sparse) + " generations and whenever the best optimized count or pop_uni_obj changes";
+    default: return "every " + std::to_string(interval) + " generations";
+  }
+}
+
+#endif
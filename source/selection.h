@@ -17,6 +17,9 @@
 #include "tools/Random.h"
 #include "tools/random_utils.h"
 
+///< experiment headers
+#include "stream.h"
+
 ///< constant vars
 constexpr size_t DRIFT_SIZE = 1;
 constexpr double ERROR_VALD = -1.0;
@@ -50,6 +53,15 @@ class Selection
 
     ///< helper functions
 
+    // draw from a counter-based stream instead of the shared random pointer (nullptr to go back)
+    void SetStream(emp::Ptr<Stream> s) {stream = s;}
+
+    // shuffle ids with the stream if we have one, otherwise the random pointer
+    void Shuffle(ids_t & v);
+
+    // choose K unique ids from [0,N) with the stream if we have one, otherwise the random pointer
+    ids_t Choose(const size_t N, const size_t K);
+
     // distance function between two values
     double Distance(double a, double b) {return std::abs(a - b);}
 
@@ -286,6 +298,8 @@ class Selection
 
     // random pointer from world.h
     emp::Ptr<emp::Random> random;
+    // counter-based stream from world.h (optional)
+    emp::Ptr<Stream> stream = nullptr;
 };
 
 ///< population structure
@@ -397,7 +411,7 @@ Selection::cohort_t Selection::CohortGeneration(const size_t N, const double P)
   // initialize position ids and shuffle
   ids_t pop(N);
   std::iota(pop.begin(), pop.end(), 0);
-  emp::Shuffle(*random, pop);
+  Shuffle(pop);
 
   // distrubute the shuffled population ids into the cohorts
   emp_assert(cohorts.size() == coh_num);
@@ -585,7 +599,7 @@ Selection::ids_t Selection::MLSelect(const size_t mu, const size_t lambda, const
   for(auto & g : group)
   {
     auto gt = g.second;
-    emp::Shuffle(*random, gt);
+    Shuffle(gt);
     for(auto id : gt)
     {
       topmu.push_back(id);
@@ -615,7 +629,7 @@ size_t Selection::Tournament(const size_t t, const score_t & score)
   emp_assert(t <= score.size());
 
   // get tournament ids
-  emp::vector<size_t> tour = emp::Choose(*random, score.size(), t);
+  emp::vector<size_t> tour = Choose(score.size(), t);
 
   // store all scores for the tournament
   emp::vector<double> subscore(t);
@@ -626,7 +640,7 @@ size_t Selection::Tournament(const size_t t, const score_t & score)
   emp::vector<size_t> opt = group.begin()->second;
 
   //shuffle the vector with best fitness ids
-  emp::Shuffle(*random, opt);
+  Shuffle(opt);
   emp_assert(0 < opt.size());
 
   return tour[opt[0]];
@@ -638,7 +652,7 @@ size_t Selection::Drift(const size_t size)
   emp_assert(size > 0);
 
   // return a random org id
-  auto win = emp::Choose(*random, size, DRIFT_SIZE);
+  auto win = Choose(size, DRIFT_SIZE);
   emp_assert(win.size() == DRIFT_SIZE);
 
   return win[0];
@@ -652,7 +666,7 @@ size_t Selection::EpsiLexicase(const fmatrix_t & mscore, const double epsi, cons
   // create vector of shuffled testcase ids
   ids_t test_id(M);
   std::iota(test_id.begin(), test_id.end(), 0);
-  emp::Shuffle(*random, test_id);
+  Shuffle(test_id);
 
   // vector to hold filterd elite solutions
   ids_t filter(mscore.size());
@@ -697,7 +711,7 @@ size_t Selection::EpsiLexicase(const fmatrix_t & mscore, const double epsi, cons
 
   // Get a random position from the remaining filtered solutions (may be one left too)
   emp_assert(0 < filter.size());
-  size_t wid = emp::Choose(*random, filter.size(), 1)[0];
+  size_t wid = Choose(filter.size(), 1)[0];
 
   return filter[wid];
 }
@@ -711,7 +725,7 @@ size_t Selection::DSELexicase(const fmatrix_t & mscore, const double epsi, const
   // create a vector of shuffled testcase ids
   ids_t test_id(t_cases.size());
   std::iota(test_id.begin(), test_id.end(), 0);
-  emp::Shuffle(*random, test_id);
+  Shuffle(test_id);
 
   // create vector to hold filtered elite solutions
   ids_t filter(mscore.size());
@@ -755,7 +769,7 @@ size_t Selection::DSELexicase(const fmatrix_t & mscore, const double epsi, const
 
   // Get a random position from the remaining filtered solutions (may be one left too)
   emp_assert(0 < filter.size());
-  size_t wid = emp::Choose(*random, filter.size(), 1)[0];
+  size_t wid = Choose(filter.size(), 1)[0];
 
   return filter[wid];
 }
@@ -769,7 +783,7 @@ size_t Selection::CELexicase(const fmatrix_t & mscore, const double epsi, const
   // create a vector of shuffled testcase ids
   ids_t test_id(test_coh.size());
   std::iota(test_id.begin(), test_id.end(), 0);
-  emp::Shuffle(*random, test_id);
+  Shuffle(test_id);
 
   // create vector to hold filtered elite solutions from pop_coh
   ids_t filter(pop_coh.size());
@@ -816,13 +830,28 @@ size_t Selection::CELexicase(const fmatrix_t & mscore, const double epsi, const
 
   // Get a random position from the remaining filtered solutions (may be one left too)
   emp_assert(0 < filter.size());
-  size_t wid = emp::Choose(*random, filter.size(), 1)[0];
+  size_t wid = Choose(filter.size(), 1)[0];
 
   return pop_coh[filter[wid]];
 }
 
 ///< helper functions
 
+void Selection::Shuffle(ids_t & v)
+{
+  if(stream) {stream->Shuffle(v);}
+  else {emp::Shuffle(*random, v);}
+}
+
+Selection::ids_t Selection::Choose(const size_t N, const size_t K)
+{
+  // quick checks
+  emp_assert(K <= N);
+
+  if(stream) {return stream->Choose(N, K);}
+  return emp::Choose(*random, N, K);
+}
+
 double Selection::Pnorm(const score_t & x, const score_t & y, const double exp)
 {
   // quick checks
@@ -0,0 +1,330 @@
+/// Population snapshots (pop_<gen>.snap): every solution of a generation in a fixed layout, so analysis tools can mmap
+/// the file and read any column in place (SnapshotReader below, or e.g. numpy.memmap at the offsets in the header)
+///
+/// Layout (native byte order, like checkpoints, every section starts on a 64 byte boundary):
+///   header   snap::Header ("DIASNAP1", generation, sizes of the run and the offset of every section)
+///   genome   pop x obj doubles, row major (solution i at genome + i * obj)
+///   score    pop x obj doubles, row major
+///   optimal  pop rows of words u64s, bit j % 64 of word j / 64 set if objective j is optimized
+///   clone    pop u8, 1 if the solution is an unmutated clone of its parent
+///   start    pop u64, starting position of every solution
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+///< standard headers
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+///< system headers
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DIA_SNAP_MMAP
+#endif
+
+///< empirical headers
+#include "base/vector.h"
+
+namespace snap
+{
+  // marks a snapshot file
+  constexpr char MAGIC[8] = {'D','I','A','S','N','A','P','1'};
+  constexpr uint32_t VERSION = 1;
+  // reads back as something else on a machine of the other byte order
+  constexpr uint32_t ENDIAN = 0x01020304;
+  // section alignment (a cache line, and enough for any vector load)
+  constexpr uint64_t ALIGN = 64;
+
+  // first bytes of the file
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint64_t header_size;
+    // generation and run the population belongs to
+    uint64_t gen;
+    int64_t seed;
+    uint64_t selection;
+    uint64_t diagnostic;
+    // matrix sizes, and u64 words per row of optimal bits
+    uint64_t pop_size;
+    uint64_t objective_cnt;
+    uint64_t words;
+    // byte offset of every section, and of the end of the file
+    uint64_t genome;
+    uint64_t score;
+    uint64_t optimal;
+    uint64_t clone;
+    uint64_t start;
+    uint64_t size;
+  };
+
+  inline uint64_t Align(const uint64_t at) {return (at + ALIGN - 1) / ALIGN * ALIGN;}
+
+  // header of a population, with the sections laid out
+  Header Layout(const uint64_t gen, const uint64_t pop_size, const uint64_t objective_cnt);
+}
+
+/// Population of one generation, written in the background
+/// Holds read only handles to org storage, so copy-on-write keeps them unchanged while the file is written
+struct PopSnapshot
+{
+  using doubles_ptr_t = std::shared_ptr<const emp::vector<double>>;
+  using bools_ptr_t = std::shared_ptr<const emp::vector<bool>>;
+
+  // generation and run
+  uint64_t gen = 0;
+  int64_t seed = 0;
+  uint64_t selection = 0;
+  uint64_t diagnostic = 0;
+  uint64_t objective_cnt = 0;
+
+  // by position id
+  emp::vector<doubles_ptr_t> genome;
+  emp::vector<doubles_ptr_t> score;
+  emp::vector<bools_ptr_t> optimal;
+  emp::vector<uint8_t> clone;
+  emp::vector<uint64_t> start;
+
+  // add the solution at the next position id
+  void Add(doubles_ptr_t g, doubles_ptr_t s, bools_ptr_t o, const bool c, const uint64_t st);
+
+  /**
+   * Write function:
+   *
+   * Writes the snapshot to path + ".tmp", then renames it over path.
+   *
+   * @param path Where the snapshot goes.
+   *
+   * @return True if the snapshot made it to disk.
+   */
+  bool Write(const std::string & path) const;
+};
+
+/// Maps a pop_<gen>.snap file and hands out its columns without copying them
+class SnapshotReader
+{
+  public:
+
+    SnapshotReader() {;}
+    SnapshotReader(const SnapshotReader &) = delete;
+    SnapshotReader & operator=(const SnapshotReader &) = delete;
+    ~SnapshotReader() {Close();}
+
+    // map path, false (with the reason on std::cerr) if it is not a snapshot of this machine's byte order
+    bool Open(const std::string & path);
+
+    // unmap the file (pointers handed out so far go stale)
+    void Close();
+
+    ///< getters
+
+    const snap::Header & GetHeader() const {return *head;}
+    uint64_t GetGen() const {return head->gen;}
+    size_t GetPopSize() const {return head->pop_size;}
+    size_t GetObjectiveCnt() const {return head->objective_cnt;}
+
+    // whole matrices (row major), and the row of solution i
+    const double * Genomes() const {return At<double>(head->genome);}
+    const double * Scores() const {return At<double>(head->score);}
+    const double * Genome(const size_t i) const {return Genomes() + i * head->objective_cnt;}
+    const double * Score(const size_t i) const {return Scores() + i * head->objective_cnt;}
+
+    // optimal bits of solution i, and one of them
+    const uint64_t * OptimalBits(const size_t i) const {return At<uint64_t>(head->optimal) + i * head->words;}
+    bool Optimal(const size_t i, const size_t j) const {return (OptimalBits(i)[j / 64] >> (j % 64)) & 1;}
+
+    // per solution columns
+    const uint8_t * Clones() const {return At<uint8_t>(head->clone);}
+    const uint64_t * Starts() const {return At<uint64_t>(head->start);}
+    bool Clone(const size_t i) const {return Clones()[i];}
+    uint64_t Start(const size_t i) const {return Starts()[i];}
+
+  private:
+    template <typename T>
+    const T * At(const uint64_t offset) const {return reinterpret_cast<const T *>(base + offset);}
+
+  private:
+    const char * base = nullptr;
+    const snap::Header * head = nullptr;
+    size_t length = 0;
+    // the file when it could not be mapped
+    emp::vector<uint64_t> copy;
+};
+
+snap::Header snap::Layout(const uint64_t gen, const uint64_t pop_size, const uint64_t objective_cnt)
+{
+  Header head;
+  std::memset(&head, 0, sizeof(head));
+  std::memcpy(head.magic, MAGIC, sizeof(MAGIC));
+  head.version = VERSION;
+  head.endian = ENDIAN;
+  head.header_size = sizeof(Header);
+  head.gen = gen;
+  head.pop_size = pop_size;
+  head.objective_cnt = objective_cnt;
+  head.words = (objective_cnt + 63) / 64;
+
+  const uint64_t matrix = pop_size * objective_cnt * sizeof(double);
+  head.genome = Align(sizeof(Header));
+  head.score = Align(head.genome + matrix);
+  head.optimal = Align(head.score + matrix);
+  head.clone = Align(head.optimal + pop_size * head.words * sizeof(uint64_t));
+  head.start = Align(head.clone + pop_size);
+  head.size = head.start + pop_size * sizeof(uint64_t);
+
+  return head;
+}
+
+void PopSnapshot::Add(doubles_ptr_t g, doubles_ptr_t s, bools_ptr_t o, const bool c, const uint64_t st)
+{
+  // quick checks
+  emp_assert(g && s && o);
+  emp_assert(g->size() == objective_cnt); emp_assert(s->size() == objective_cnt); emp_assert(o->size() == objective_cnt);
+
+  genome.push_back(g); score.push_back(s); optimal.push_back(o);
+  clone.push_back(c); start.push_back(st);
+}
+
+bool PopSnapshot::Write(const std::string & path) const
+{
+  snap::Header head = snap::Layout(gen, genome.size(), objective_cnt);
+  head.seed = seed;
+  head.selection = selection;
+  head.diagnostic = diagnostic;
+
+  const std::string tmp = path + ".tmp";
+  {
+    std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+    if(!os)
+    {
+      std::cerr << "ERROR: COULD NOT OPEN SNAPSHOT " << tmp << std::endl;
+      return false;
+    }
+
+    // zeros up to the next section
+    const char zeros[snap::ALIGN] = {};
+    auto pad = [&os, &zeros](const uint64_t to) {os.write(zeros, to - static_cast<uint64_t>(os.tellp()));};
+
+    os.write(reinterpret_cast<const char *>(&head), sizeof(head));
+
+    pad(head.genome);
+    for(const auto & g : genome) {os.write(reinterpret_cast<const char *>(g->data()), objective_cnt * sizeof(double));}
+    pad(head.score);
+    for(const auto & s : score) {os.write(reinterpret_cast<const char *>(s->data()), objective_cnt * sizeof(double));}
+
+    pad(head.optimal);
+    emp::vector<uint64_t> words(head.words);
+    for(const auto & o : optimal)
+    {
+      std::fill(words.begin(), words.end(), 0);
+      for(size_t j = 0; j < objective_cnt; ++j) {if((*o)[j]) {words[j / 64] |= uint64_t(1) << (j % 64);}}
+      os.write(reinterpret_cast<const char *>(words.data()), words.size() * sizeof(uint64_t));
+    }
+
+    pad(head.clone);
+    os.write(reinterpret_cast<const char *>(clone.data()), clone.size());
+    pad(head.start);
+    os.write(reinterpret_cast<const char *>(start.data()), start.size() * sizeof(uint64_t));
+
+    os.flush();
+    if(!os)
+    {
+      std::cerr << "ERROR: COULD NOT WRITE SNAPSHOT " << tmp << std::endl;
+      return false;
+    }
+  }
+
+  // a reader never sees half a snapshot
+  std::error_code err;
+  std::filesystem::rename(tmp, path, err);
+  if(err)
+  {
+    std::cerr << "ERROR: COULD NOT MOVE SNAPSHOT INTO " << path << ": " << err.message() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool SnapshotReader::Open(const std::string & path)
+{
+  Close();
+
+#ifdef DIA_SNAP_MMAP
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  struct stat st;
+  if(fd < 0 || ::fstat(fd, &st) != 0)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;
+    if(0 <= fd) {::close(fd);}
+    return false;
+  }
+
+  length = static_cast<size_t>(st.st_size);
+  void * map = length ? ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if(map == MAP_FAILED)
+  {
+    std::cerr << "ERROR: COULD NOT MAP " << path << std::endl;
+    length = 0;
+    return false;
+  }
+  base = static_cast<const char *>(map);
+#else
+  // no mmap here, so the file is read into memory (kept 8 byte aligned)
+  std::ifstream is(path, std::ios::binary | std::ios::ate);
+  if(!is)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;
+    return false;
+  }
+  length = static_cast<size_t>(is.tellg());
+  copy.resize((length + 7) / 8);
+  is.seekg(0);
+  is.read(reinterpret_cast<char *>(copy.data()), length);
+  base = reinterpret_cast<const char *>(copy.data());
+#endif
+
+  // the header has to describe exactly this file
+  head = reinterpret_cast<const snap::Header *>(base);
+  bool good = sizeof(snap::Header) <= length && !std::memcmp(head->magic, snap::MAGIC, sizeof(snap::MAGIC));
+  good = good && head->version == snap::VERSION && head->endian == snap::ENDIAN && head->header_size == sizeof(snap::Header);
+  if(good)
+  {
+    const snap::Header want = snap::Layout(head->gen, head->pop_size, head->objective_cnt);
+    good = head->words == want.words && head->genome == want.genome && head->score == want.score && head->optimal == want.optimal
+        && head->clone == want.clone && head->start == want.start && head->size == want.size && want.size <= length;
+  }
+
+  if(!good)
+  {
+    std::cerr << "ERROR: " << path << " IS NOT A POPULATION SNAPSHOT OF THIS KIND OF MACHINE" << std::endl;
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void SnapshotReader::Close()
+{
+#ifdef DIA_SNAP_MMAP
+  if(base) {::munmap(const_cast<char *>(base), length);}
+#endif
+  copy.clear();
+  base = nullptr;
+  head = nullptr;
+  length = 0;
+}
+
+#endif
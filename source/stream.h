@@ -0,0 +1,424 @@
+/// Counter-based random number streams for the stochastic operators
+/// Every stream is keyed by (seed, generation, phase, individual), so draws do not depend on call order
+/// Words and normals are generated in bulk batches that the compiler can vectorize, sized to what the bulk draws ask for
+
+#ifndef STREAM_H
+#define STREAM_H
+
+///< standard headers
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+///< empirical headers
+#include "base/vector.h"
+
+class Stream
+{
+  // object types we are using in this class
+  public:
+    // philox counter block
+    using ctr_t = std::array<uint32_t, 4>;
+    // philox key
+    using key_t = std::array<uint32_t, 2>;
+    // vector of any ids
+    using ids_t = emp::vector<size_t>;
+
+    // phases of a generation that draw random numbers (one stream family each)
+    enum Phase : uint32_t
+    {
+      MUTATION = 0,
+      SELECTION = 1,
+      COHORT = 2,
+      DOWNSAMPLE = 3,
+      MIGRATION = 4
+    };
+
+
+  public:
+
+    Stream(const uint64_t seed = 0)
+    {
+      key[0] = static_cast<uint32_t>(seed);
+      key[1] = static_cast<uint32_t>(seed >> 32);
+      Key(0, MUTATION, 0);
+    }
+
+    ///< stream keying
+
+    /**
+     * Key function:
+     *
+     * Points this stream at the start of the sequence for (generation, phase, individual).
+     * The same key always gives the same sequence, no matter what was drawn before.
+     *
+     * @param gen Generation the draws belong to.
+     * @param phase Phase of the generation the draws belong to.
+     * @param id Individual (or slot) the draws belong to.
+     */
+    void Key(const uint64_t gen, const uint32_t phase, const uint64_t id)
+    {
+      ctr[0] = 0;
+      ctr[1] = static_cast<uint32_t>(id);
+      ctr[2] = static_cast<uint32_t>(gen);
+      ctr[3] = phase | (static_cast<uint32_t>(gen >> 32) << 8) | (static_cast<uint32_t>(id >> 32) << 20);
+
+      // normals come from their own sub-stream so mixing draw types never shifts either sequence
+      nctr = ctr;
+      nctr[3] |= NORMAL_BIT;
+
+      // start small, every refill for this key doubles in size
+      pos = 0; len = 0; blocks = 1;
+      npos = 0; nlen = 0; nblocks = 1;
+    }
+
+    /**
+     * Philox function:
+     *
+     * Philox4x32-10 block function from:
+     * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, "Parallel random numbers: as easy as 1, 2, 3,"
+     * in Proceedings of the International Conference for High Performance Computing, Networking, Storage and Analysis, 2011.
+     *
+     * @param c Counter block.
+     * @param k Key.
+     *
+     * @return Four random 32 bit words.
+     */
+    static ctr_t Philox(ctr_t c, key_t k);
+
+    /**
+     * Bulk Philox function:
+     *
+     * Same as Philox, but for 'cnt' consecutive counter blocks at once.
+     * Blocks are laid out as separate lanes so the compiler can vectorize the rounds across them.
+     *
+     * @param c First counter block (first word is bumped for every following block).
+     * @param k Key.
+     * @param cnt Number of blocks to generate (at most MAX_BLOCKS).
+     * @param out Where the 4 * cnt words are written.
+     */
+    static void Philox(const ctr_t & c, const key_t & k, const size_t cnt, uint32_t * out);
+
+    /**
+     * Box-Muller function:
+     *
+     * Turns 'cnt' random words into 'cnt' unit normals, two at a time.
+     *
+     * @param words Random words ('cnt' must be even).
+     * @param cnt Number of words and normals.
+     * @param out Where the normals are written.
+     */
+    static void BoxMuller(const uint32_t * words, const size_t cnt, double * out);
+
+    /**
+     * Draw Seed function:
+     *
+     * Seed for a run configured with SEED 0 (or less). The clock and a per process counter are mixed
+     * through Philox, so runs started at the same time still get different seeds.
+     * A run draws it once and keys its emp::Random and every stream with it.
+     *
+     * @return Seed in [1, INT_MAX / 2] (islands add their index to it).
+     */
+    static int DrawSeed();
+
+
+    ///< draws (same names as emp::Random)
+
+    // next random 32 bit word
+    uint32_t Get()
+    {
+      if(pos == len) {Refill();}
+      return words[pos++];
+    }
+
+    // uniform double in [0,1)
+    double GetDouble() {return Get() / RAND_CAP;}
+    // uniform double in [min,max)
+    double GetDouble(const double min, const double max) {return GetDouble() * (max - min) + min;}
+    // uniform integer in [0,max)
+    uint32_t GetUInt(const uint32_t max) {return static_cast<uint32_t>((static_cast<uint64_t>(Get()) * max) >> 32);}
+    // uniform integer in [min,max)
+    uint32_t GetUInt(const uint32_t min, const uint32_t max) {return GetUInt(max - min) + min;}
+    // true with probability p
+    bool P(const double p) {return Get() < (p * RAND_CAP);}
+
+    // normal random variable
+    double GetRandNormal(const double mean, const double std)
+    {
+      if(npos == nlen) {RefillNormal();}
+      return mean + norms[npos++] * std;
+    }
+
+
+    ///< bulk draws (same sequence as calling the single draws 'cnt' times)
+
+    // fill with random 32 bit words
+    void GetWords(uint32_t * out, const size_t cnt);
+
+    // fill with uniform doubles in [0,1)
+    void GetDoubles(double * out, const size_t cnt);
+
+    // fill with normal random variables
+    void GetRandNormals(double * out, const size_t cnt, const double mean, const double std);
+
+
+    ///< helpers matching tools/random_utils.h
+
+    // shuffle a vector in place (words are drawn in bulk, same order as one GetUInt per position)
+    template <typename T>
+    void Shuffle(emp::vector<T> & v)
+    {
+      uint32_t draws[BLOCK * MAX_BLOCKS];
+      for(size_t i = 0; i + 1 < v.size();)
+      {
+        const size_t cnt = std::min(v.size() - 1 - i, BLOCK * MAX_BLOCKS);
+        GetWords(draws, cnt);
+
+        for(size_t j = 0; j < cnt; ++j, ++i)
+        {
+          const size_t pos = i + static_cast<size_t>((static_cast<uint64_t>(draws[j]) * (v.size() - i)) >> 32);
+          if(pos != i) {std::swap(v[i], v[pos]);}
+        }
+      }
+    }
+
+    // choose K unique ids from [0,N)
+    ids_t Choose(size_t N, size_t K);
+
+  private:
+    // generate the next batch of words (at least 'want' blocks of them, up to MAX_BLOCKS)
+    void Refill(const size_t want = 0);
+
+    // generate the next batch of normals (at least 'want' blocks of them, up to MAX_BLOCKS)
+    void RefillNormal(const size_t want = 0);
+
+    // blocks that hold 'cnt' draws
+    static size_t Blocks(const size_t cnt) {return (cnt + BLOCK - 1) / BLOCK;}
+
+  public:
+    // words per philox block
+    static constexpr size_t BLOCK = 4;
+    // most blocks generated in one batch
+    static constexpr size_t MAX_BLOCKS = 64;
+
+  private:
+    // 2^32 for turning words into doubles
+    static constexpr double RAND_CAP = 4294967296.0;
+    // for the Box-Muller angle
+    static constexpr double PI = 3.14159265358979323846;
+    // phase bit reserved for the normal sub-stream
+    static constexpr uint32_t NORMAL_BIT = 0x80;
+
+    // key (derived from the seed)
+    key_t key;
+    // counter (draw block, individual, generation, phase)
+    ctr_t ctr;
+    // counter for the normal sub-stream
+    ctr_t nctr;
+
+    // batch of words, position in it and its size
+    uint32_t words[BLOCK * MAX_BLOCKS];
+    size_t pos = 0; size_t len = 0;
+    // blocks in next word batch
+    size_t blocks = 1;
+
+    // batch of unit normals, position in it and its size
+    double norms[BLOCK * MAX_BLOCKS];
+    size_t npos = 0; size_t nlen = 0;
+    // blocks in next normal batch
+    size_t nblocks = 1;
+};
+
+///< stream keying
+
+Stream::ctr_t Stream::Philox(ctr_t c, key_t k)
+{
+  // multipliers and key schedule constants
+  constexpr uint64_t M0 = 0xD2511F53; constexpr uint64_t M1 = 0xCD9E8D57;
+  constexpr uint32_t W0 = 0x9E3779B9; constexpr uint32_t W1 = 0xBB67AE85;
+
+  for(size_t r = 0; r < 10; ++r)
+  {
+    const uint64_t p0 = M0 * c[0];
+    const uint64_t p1 = M1 * c[2];
+
+    c = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<uint32_t>(p1),
+         static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<uint32_t>(p0)};
+
+    k[0] += W0; k[1] += W1;
+  }
+
+  return c;
+}
+
+void Stream::Philox(const ctr_t & c, const key_t & k, const size_t cnt, uint32_t * out)
+{
+  // quick checks
+  emp_assert(0 < cnt); emp_assert(cnt <= MAX_BLOCKS);
+
+  // multipliers and key schedule constants
+  constexpr uint64_t M0 = 0xD2511F53; constexpr uint64_t M1 = 0xCD9E8D57;
+  constexpr uint32_t W0 = 0x9E3779B9; constexpr uint32_t W1 = 0xBB67AE85;
+
+  // one lane per block
+  uint32_t c0[MAX_BLOCKS]; uint32_t c1[MAX_BLOCKS]; uint32_t c2[MAX_BLOCKS]; uint32_t c3[MAX_BLOCKS];
+  for(size_t l = 0; l < cnt; ++l)
+  {
+    c0[l] = c[0] + static_cast<uint32_t>(l); c1[l] = c[1]; c2[l] = c[2]; c3[l] = c[3];
+  }
+
+  uint32_t k0 = k[0]; uint32_t k1 = k[1];
+  for(size_t r = 0; r < 10; ++r)
+  {
+    for(size_t l = 0; l < cnt; ++l)
+    {
+      const uint64_t p0 = M0 * c0[l];
+      const uint64_t p1 = M1 * c2[l];
+
+      c0[l] = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+      c1[l] = static_cast<uint32_t>(p1);
+      c2[l] = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+      c3[l] = static_cast<uint32_t>(p0);
+    }
+
+    k0 += W0; k1 += W1;
+  }
+
+  // same word order as calling Philox block by block
+  for(size_t l = 0; l < cnt; ++l)
+  {
+    out[BLOCK * l] = c0[l]; out[BLOCK * l + 1] = c1[l]; out[BLOCK * l + 2] = c2[l]; out[BLOCK * l + 3] = c3[l];
+  }
+}
+
+int Stream::DrawSeed()
+{
+  static std::atomic<uint32_t> drawn{0};
+
+  const uint64_t ns = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+  const ctr_t c = {drawn.fetch_add(1), 0, 0, 0};
+  const ctr_t w = Philox(c, {static_cast<uint32_t>(ns), static_cast<uint32_t>(ns >> 32)});
+
+  return 1 + static_cast<int>(w[0] % static_cast<uint32_t>(INT_MAX / 2));
+}
+
+void Stream::BoxMuller(const uint32_t * words, const size_t cnt, double * out)
+{
+  // quick checks
+  emp_assert(cnt % 2 == 0);
+
+  for(size_t i = 0; i < cnt; i += 2)
+  {
+    // 1 - [0,1) keeps us away from log(0)
+    const double rad = std::sqrt(-2.0 * std::log(1.0 - words[i] / RAND_CAP));
+    const double ang = 2.0 * PI * (words[i + 1] / RAND_CAP);
+
+    out[i] = rad * std::cos(ang);
+    out[i + 1] = rad * std::sin(ang);
+  }
+}
+
+void Stream::Refill(const size_t want)
+{
+  blocks = std::max(blocks, std::min(want, MAX_BLOCKS));
+
+  Philox(ctr, key, blocks, words);
+  ctr[0] += static_cast<uint32_t>(blocks);
+  pos = 0; len = BLOCK * blocks;
+
+  // streams that keep drawing get bigger batches
+  blocks = std::min(2 * blocks, MAX_BLOCKS);
+}
+
+void Stream::RefillNormal(const size_t want)
+{
+  nblocks = std::max(nblocks, std::min(want, MAX_BLOCKS));
+
+  uint32_t raw[BLOCK * MAX_BLOCKS];
+  Philox(nctr, key, nblocks, raw);
+  nctr[0] += static_cast<uint32_t>(nblocks);
+
+  BoxMuller(raw, BLOCK * nblocks, norms);
+  npos = 0; nlen = BLOCK * nblocks;
+
+  // streams that keep drawing get bigger batches
+  nblocks = std::min(2 * nblocks, MAX_BLOCKS);
+}
+
+
+///< bulk draws
+
+void Stream::GetWords(uint32_t * out, const size_t cnt)
+{
+  size_t i = 0;
+  while(i < cnt)
+  {
+    // a fresh batch covers everything still asked for (up to MAX_BLOCKS), instead of growing block by block
+    if(pos == len) {Refill(Blocks(cnt - i));}
+
+    const size_t take = std::min(len - pos, cnt - i);
+    std::copy(words + pos, words + pos + take, out + i);
+
+    pos += take; i += take;
+  }
+}
+
+void Stream::GetDoubles(double * out, const size_t cnt)
+{
+  size_t i = 0;
+  while(i < cnt)
+  {
+    if(pos == len) {Refill(Blocks(cnt - i));}
+
+    // convert as much of the current batch as we can in one go
+    const size_t take = std::min(len - pos, cnt - i);
+    for(size_t j = 0; j < take; ++j) {out[i + j] = words[pos + j] / RAND_CAP;}
+
+    pos += take; i += take;
+  }
+}
+
+void Stream::GetRandNormals(double * out, const size_t cnt, const double mean, const double std)
+{
+  size_t i = 0;
+  while(i < cnt)
+  {
+    if(npos == nlen) {RefillNormal(Blocks(cnt - i));}
+
+    // scale as much of the current batch as we can in one go
+    const size_t take = std::min(nlen - npos, cnt - i);
+    for(size_t j = 0; j < take; ++j) {out[i + j] = mean + norms[npos + j] * std;}
+
+    npos += take; i += take;
+  }
+}
+
+
+///< helpers
+
+Stream::ids_t Stream::Choose(size_t N, size_t K)
+{
+  // quick checks
+  emp_assert(K <= N);
+
+  // selection sampling, keeps every id with probability (still needed / still left)
+  ids_t choices(K);
+  while(K)
+  {
+    if(N == K || P(static_cast<double>(K) / static_cast<double>(N)))
+    {
+      choices[choices.size() - K] = N - 1;
+      --K;
+    }
+    --N;
+  }
+
+  return choices;
+}
+
+#endif
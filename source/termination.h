@@ -0,0 +1,187 @@
+/// Early termination: stopping criteria checked once every generation has been recorded
+/// The first criterion that fires ends the run, and its reason is kept for the output
+
+#ifndef TERMINATION_H
+#define TERMINATION_H
+
+///< standard headers
+#include <chrono>
+#include <csignal>
+#include <functional>
+#include <string>
+#include <utility>
+
+///< empirical headers
+#include "base/vector.h"
+
+///< experiment headers
+#include "config.h"
+
+/// What the criteria get to look at after a generation
+struct Status
+{
+  // generation just recorded
+  size_t gen = 0;
+  // elite aggregate performance (ele_agg_per)
+  double ele_agg = 0.0;
+  // largest optimized objective count in the population
+  size_t opt_cnt = 0;
+  // unique optimized objectives (pop_uni_obj, only filled when a criterion watches it)
+  size_t uni_obj = 0;
+  // solutions evaluated so far
+  size_t evals = 0;
+  // objective evaluations so far
+  size_t obj_evals = 0;
+};
+
+class Termination
+{
+  // object types we are using in this class
+  public:
+    // custom criterion, true means stop
+    using pred_t = std::function<bool(const Status &)>;
+    // clock for the wall clock budget
+    using clock_t = std::chrono::steady_clock;
+
+    // metric watched for stagnation
+    enum Metric : size_t {ELE_AGG_PER = 0, POP_UNI_OBJ = 1};
+
+
+  public:
+
+    Termination(DiaConfig & _config) : config(_config), begin(clock_t::now()) {;}
+
+    ///< helper functions
+
+    // is any criterion switched on?
+    static bool Enabled(const DiaConfig & config)
+    {
+      return config.STOP_OPTIMIZED() || config.STAG_GENS() || config.MAX_EVALS() || 0.0 < config.MAX_SECONDS();
+    }
+
+    // does the status need pop_uni_obj filled in?
+    bool WatchesUnique() const {return config.STAG_GENS() && config.STAG_METRIC() == POP_UNI_OBJ;}
+
+    ///< signals (a SIGINT or SIGTERM ends the run after the current generation, a second one kills it)
+
+    // make SIGINT and SIGTERM set Signaled instead of killing the process
+    static void CatchSignals();
+
+    // signal caught so far (0 if none)
+    static int Signaled() {return signaled;}
+
+    // add a criterion of our own (checked after the configured ones)
+    void Add(const std::string & reason, pred_t pred) {custom.emplace_back(reason, pred);}
+
+    /**
+     * Check function:
+     *
+     * Runs every criterion on the status of the generation just recorded.
+     * Must be called once per generation, in order, for the stagnation count to be right.
+     *
+     * @param status Generation status.
+     *
+     * @return True if the run should stop (GetReason says why).
+     */
+    bool Check(const Status & status);
+
+    // why we stopped (empty while running)
+    const std::string & GetReason() const {return reason;}
+
+    ///< stagnation state (carried across checkpoints)
+
+    double GetStagBest() const {return stag_best;}
+    size_t GetStagSince() const {return stag_since;}
+    void SetStagnation(const double best, const size_t since) {stag_best = best; stag_since = since; stag_seen = true;}
+
+  private:
+    // experiment configurations
+    DiaConfig & config;
+    // when the run (or this resumed part of it) started
+    clock_t::time_point begin;
+
+    // best value of the stagnation metric so far and the generation it was reached
+    double stag_best = 0.0;
+    size_t stag_since = 0;
+    bool stag_seen = false;
+
+    // custom criteria (reason, predicate)
+    emp::vector<std::pair<std::string, pred_t>> custom;
+
+    // reason the run stopped
+    std::string reason = "";
+
+    // set from the signal handler
+    static inline volatile std::sig_atomic_t signaled = 0;
+};
+
+void Termination::CatchSignals()
+{
+  auto handler = [](int sig)
+  {
+    signaled = sig;
+    // the next one goes straight through
+    std::signal(sig, SIG_DFL);
+  };
+
+  std::signal(SIGINT, handler);
+  std::signal(SIGTERM, handler);
+}
+
+bool Termination::Check(const Status & status)
+{
+  // full optimization
+  if(config.STOP_OPTIMIZED() && config.OBJECTIVE_CNT() <= status.opt_cnt)
+  {
+    reason = "optimized";
+    return true;
+  }
+
+  // stagnation (any strict improvement restarts the count)
+  if(config.STAG_GENS())
+  {
+    const double val = (config.STAG_METRIC() == POP_UNI_OBJ) ? static_cast<double>(status.uni_obj) : status.ele_agg;
+    if(!stag_seen || stag_best < val)
+    {
+      stag_best = val;
+      stag_since = status.gen;
+      stag_seen = true;
+    }
+    else if(config.STAG_GENS() <= status.gen - stag_since)
+    {
+      reason = (config.STAG_METRIC() == POP_UNI_OBJ) ? "stagnation_pop_uni_obj" : "stagnation_ele_agg_per";
+      return true;
+    }
+  }
+
+  // evaluation budget
+  if(config.MAX_EVALS() && config.MAX_EVALS() <= status.obj_evals)
+  {
+    reason = "max_evals";
+    return true;
+  }
+
+  // wall clock budget
+  if(0.0 < config.MAX_SECONDS())
+  {
+    const double secs = std::chrono::duration<double>(clock_t::now() - begin).count();
+    if(config.MAX_SECONDS() <= secs)
+    {
+      reason = "max_seconds";
+      return true;
+    }
+  }
+
+  for(const auto & c : custom)
+  {
+    if(c.second(status))
+    {
+      reason = c.first;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#endif
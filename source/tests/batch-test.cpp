@@ -0,0 +1,32 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/batch.h"
+
+// library includes
+#include <string>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -pthread -I ../../../Empirical/source/ batch-test.cpp -o batch-test; ./batch-test
+
+TEST_CASE("Manifest lines", "[parse]")
+{
+  Batch::overrides_t over; std::string err;
+
+  // flags come out in order, trailing comments are dropped
+  REQUIRE(Batch::ParseLine("-SEED 130001 -SELECTION 6 -OUTPUT_DIR data/RUN_C0_130001/  # cohort", over, err));
+  REQUIRE(over.size() == 3);
+  REQUIRE(over[0].first == "SEED"); REQUIRE(over[0].second == "130001");
+  REQUIRE(over[1].first == "SELECTION"); REQUIRE(over[1].second == "6");
+  REQUIRE(over[2].first == "OUTPUT_DIR"); REQUIRE(over[2].second == "data/RUN_C0_130001/");
+
+  // blank and comment lines hold no run
+  REQUIRE(Batch::ParseLine("", over, err)); REQUIRE(over.empty());
+  REQUIRE(Batch::ParseLine("   # nothing here", over, err)); REQUIRE(over.empty());
+
+  // malformed lines are rejected
+  REQUIRE(!Batch::ParseLine("SEED 1", over, err));
+  REQUIRE(!Batch::ParseLine("-SEED", over, err));
+  REQUIRE(err == "missing value for -SEED");
+}
@@ -0,0 +1,132 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/checkpoint.h"
+
+// empirical headers
+#include "base/vector.h"
+#include "tools/Random.h"
+
+// library includes
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ checkpoint-test.cpp -o checkpoint-test; ./checkpoint-test
+
+TEST_CASE("Checkpoint round trip", "[write][read]")
+{
+  // one plain org and one clone carrying its parent's phenotype
+  Org plain(Org::genome_t({1.0, 2.5, -0.0}));
+
+  Org clone(Org::genome_t({3.0, 0.125, 7.0}));
+  clone.MeClone();
+  clone.Inherit({3.0, 0.125, 7.0}, {true, false, true}, 2, 10.125, 2);
+
+  emp::Random rng(42);
+  rng.GetDouble(); rng.GetDouble();
+
+  Checkpoint out;
+  out.update = 1000; out.seed = 42;
+  out.pop_size = 2; out.objective_cnt = 3;
+  out.data_bytes = 12345; out.col_bytes = 678;
+  out.selection = 6; out.mutate_per = 0.007; out.mutate_skip = 1;
+  out.SaveRandom(rng);
+  out.AddOrg(plain);
+  out.AddOrg(clone);
+
+  REQUIRE(out.Write("checkpoint-test.bin"));
+
+  Checkpoint in;
+  REQUIRE(in.Read("checkpoint-test.bin"));
+  REQUIRE(in.update == 1000);
+  REQUIRE(in.seed == 42);
+  REQUIRE(in.data_bytes == 12345);
+  REQUIRE(in.col_bytes == 678);
+  REQUIRE(in.selection == 6);
+  REQUIRE(in.mutate_per == 0.007);
+  REQUIRE(in.mutate_skip == 1);
+
+  // generator carries on with the same draws
+  emp::Random back(7);
+  in.LoadRandom(back);
+  for(size_t i = 0; i < 100; ++i) {REQUIRE(back.GetDouble() == rng.GetDouble());}
+
+  Org p = in.MakeOrg(0);
+  REQUIRE(p.GetGenome() == plain.GetGenome());
+  REQUIRE(!p.GetClone());
+  REQUIRE(!p.GetScored());
+
+  Org c = in.MakeOrg(1);
+  REQUIRE(c.GetGenome() == clone.GetGenome());
+  REQUIRE(c.GetClone());
+  REQUIRE(c.GetScore() == clone.GetScore());
+  REQUIRE(c.GetOptimal() == clone.GetOptimal());
+  REQUIRE(c.GetCount() == 2);
+  REQUIRE(c.GetAggregate() == 10.125);
+  REQUIRE(c.GetStart() == 2);
+
+  std::remove("checkpoint-test.bin");
+}
+
+TEST_CASE("Checkpoint damaged", "[read]")
+{
+  Org org(Org::genome_t({1.0, 2.0}));
+
+  Checkpoint out;
+  out.pop_size = 1; out.objective_cnt = 2;
+  out.AddOrg(org);
+  REQUIRE(out.Write("checkpoint-test.bin"));
+
+  // cut the file short
+  {
+    std::ifstream is("checkpoint-test.bin", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    std::ofstream os("checkpoint-test.bin", std::ios::binary | std::ios::trunc);
+    os.write(bytes.data(), bytes.size() - 3);
+  }
+
+  Checkpoint in;
+  REQUIRE(!in.Read("checkpoint-test.bin"));
+
+  std::remove("checkpoint-test.bin");
+}
+
+TEST_CASE("Checkpoint settings", "[check]")
+{
+  DiaConfig config;
+  config.SEED(5); config.POP_SIZE(2); config.OBJECTIVE_CNT(3);
+  config.OUTPUT_DIR("checkpoint-test-data/");
+  std::filesystem::create_directories(config.OUTPUT_DIR());
+  std::ofstream(config.OUTPUT_DIR() + "data.csv") << "gen\n";
+
+  Checkpoint ckpt;
+  ckpt.update = 10; ckpt.seed = 5; ckpt.pop_size = 2; ckpt.objective_cnt = 3;
+  ckpt.selection = config.SELECTION(); ckpt.diagnostic = config.DIAGNOSTIC();
+  ckpt.mutate_per = config.MUTATE_PER(); ckpt.mutate_mean = config.MEAN(); ckpt.mutate_std = config.STD();
+  ckpt.mutate_skip = config.MUTATE_SKIP(); ckpt.rng_streams = config.RNG_STREAMS();
+
+  std::string err;
+  REQUIRE(ckpt.Check(config, err));
+
+  // every setting of the experiment has to match, or the resume is turned down
+  config.SELECTION(6);
+  REQUIRE(!ckpt.Check(config, err)); REQUIRE(err.find("SELECTION") == 0);
+  config.SELECTION(ckpt.selection); config.DIAGNOSTIC(3);
+  REQUIRE(!ckpt.Check(config, err)); REQUIRE(err.find("DIAGNOSTIC") == 0);
+  config.DIAGNOSTIC(ckpt.diagnostic); config.MUTATE_PER(0.5);
+  REQUIRE(!ckpt.Check(config, err)); REQUIRE(err.find("MUTATE_PER") == 0);
+  config.MUTATE_PER(ckpt.mutate_per); config.STD(2.0);
+  REQUIRE(!ckpt.Check(config, err)); REQUIRE(err.find("MUTATE_PER") == 0);
+  config.STD(ckpt.mutate_std); config.MUTATE_SKIP(!ckpt.mutate_skip);
+  REQUIRE(!ckpt.Check(config, err)); REQUIRE(err.find("MUTATE_SKIP") == 0);
+  config.MUTATE_SKIP(ckpt.mutate_skip); config.RNG_STREAMS(!ckpt.rng_streams);
+  REQUIRE(!ckpt.Check(config, err)); REQUIRE(err.find("RNG_STREAMS") == 0);
+  config.RNG_STREAMS(ckpt.rng_streams);
+  REQUIRE(ckpt.Check(config, err));
+
+  std::filesystem::remove_all(config.OUTPUT_DIR());
+}
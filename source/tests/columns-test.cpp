@@ -0,0 +1,151 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/columns.h"
+
+// empirical headers
+#include "base/vector.h"
+
+// library includes
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ columns-test.cpp -o columns-test; ./columns-test
+
+// two columns over the rows of a made up run
+struct Rows
+{
+  size_t gen = 0;
+  double fit = 0.0;
+
+  void Register(ColumnWriter & writer)
+  {
+    writer.Add<size_t>([this]() {return gen;}, "gen", "Current generation at!");
+    writer.Add<double>([this]() {return fit;}, "fit", "Some performance!");
+  }
+
+  void Write(ColumnWriter & writer, const size_t from, const size_t to)
+  {
+    for(gen = from; gen < to; ++gen)
+    {
+      fit = (gen % 7 == 0) ? -0.5 * gen : 1.0 / (gen + 1);
+      writer.Update();
+    }
+  }
+
+  // what data.csv would hold for rows [0, to)
+  static std::string CSV(const size_t to)
+  {
+    std::ostringstream os;
+    os << "gen,fit\n";
+    for(size_t g = 0; g < to; ++g) {os << g << "," << ((g % 7 == 0) ? -0.5 * g : 1.0 / (g + 1)) << "\n";}
+    return os.str();
+  }
+};
+
+TEST_CASE("Zigzag deltas", "[encode]")
+{
+  for(uint64_t prev : {uint64_t(0), uint64_t(5), uint64_t(1) << 63})
+  {
+    for(uint64_t cur : {uint64_t(0), uint64_t(4), uint64_t(6), ~uint64_t(0)})
+    {
+      REQUIRE(col::Unzigzag(col::Zigzag(cur, prev), prev) == cur);
+    }
+  }
+  // small steps stay small
+  REQUIRE(col::Zigzag(11, 10) == 2);
+  REQUIRE(col::Zigzag(9, 10) == 1);
+}
+
+TEST_CASE("Columns round trip", "[write][read]")
+{
+  Rows rows;
+  {
+    ColumnWriter writer(16);
+    rows.Register(writer);
+    REQUIRE(writer.Open("columns-test.col"));
+    rows.Write(writer, 0, 100);
+    REQUIRE(writer.GetRows() == 100);
+  }
+
+  ColumnReader reader;
+  REQUIRE(reader.Open("columns-test.col"));
+  REQUIRE(reader.GetIndexed());
+  REQUIRE(reader.GetKeys() == emp::vector<std::string>({"gen", "fit"}));
+  REQUIRE(reader.GetTypes()[0] == col::U64);
+  REQUIRE(reader.GetTypes()[1] == col::F64);
+  REQUIRE(reader.GetBlockCnt() == 7);
+  REQUIRE(reader.GetRowCnt() == 100);
+
+  std::ostringstream os;
+  REQUIRE(reader.WriteCSV(os));
+  REQUIRE(os.str() == Rows::CSV(100));
+
+  // one column on its own matches the same column of every block
+  emp::vector<uint64_t> block, column;
+  for(size_t b = 0; b < reader.GetBlockCnt(); ++b)
+  {
+    REQUIRE(reader.ReadBlock(b, block));
+    REQUIRE(reader.ReadColumn(b, 1, column));
+    REQUIRE(column.size() * 2 == block.size());
+    for(size_t r = 0; r < column.size(); ++r) {REQUIRE(column[r] == block[r * 2 + 1]);}
+  }
+
+  reader.Close();
+  std::remove("columns-test.col");
+}
+
+TEST_CASE("Columns resume and unfinished files", "[write][read]")
+{
+  Rows rows;
+  uint64_t keep = 0;
+  {
+    ColumnWriter writer(16);
+    rows.Register(writer);
+    REQUIRE(writer.Open("columns-test.col"));
+    rows.Write(writer, 0, 40);
+
+    // a checkpoint flushes and remembers the size
+    REQUIRE(writer.Flush());
+    keep = writer.GetBytes();
+
+    // rows after the checkpoint get thrown away on resume
+    rows.Write(writer, 40, 55);
+  }
+
+  {
+    ColumnWriter writer(16);
+    rows.Register(writer);
+    REQUIRE(writer.Open("columns-test.col", keep));
+    REQUIRE(writer.GetRows() == 40);
+    rows.Write(writer, 40, 70);
+  }
+
+  ColumnReader reader;
+  REQUIRE(reader.Open("columns-test.col"));
+  std::ostringstream os;
+  REQUIRE(reader.WriteCSV(os));
+  REQUIRE(os.str() == Rows::CSV(70));
+
+  // cut off the footer and half of the last block, the full blocks are still there
+  {
+    std::ifstream is("columns-test.col", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    std::ofstream out("columns-test.col", std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), keep + 10);
+  }
+
+  REQUIRE(reader.Open("columns-test.col"));
+  REQUIRE(!reader.GetIndexed());
+  REQUIRE(reader.GetRowCnt() == 40);
+
+  // a writer with other columns cannot carry on with this file
+  ColumnWriter other;
+  other.Add<double>([]() {return 1.0;}, "gen", "Wrong type!");
+  REQUIRE(!other.Open("columns-test.col", keep));
+
+  std::remove("columns-test.col");
+}
@@ -0,0 +1,68 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/counters.h"
+
+// library includes
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ counters-test.cpp -o counters-test; ./counters-test
+// (machines without a PMU, e.g. most VMs, or perf_event_paranoid > 2 take the unavailable path)
+
+TEST_CASE("Counters open once and degrade gracefully", "[counters]")
+{
+  Counters counters;
+  REQUIRE(!counters.Tried());
+  REQUIRE(!counters.Good());
+
+  // nothing is counted before opening
+  {Counters::Sample sample = counters.Count(Timing::EVALUATE);}
+  REQUIRE(counters.GetCalls(Timing::EVALUATE) == 0);
+
+  const bool good = counters.Open();
+  REQUIRE(counters.Tried());
+  REQUIRE(counters.Good() == good);
+  REQUIRE(counters.Open() == good);
+
+  // without any counter the reasons are kept
+  if(!good) {REQUIRE(!counters.GetError().empty());}
+
+  for(size_t r = 0; r < 3; ++r)
+  {
+    Counters::Sample sample = counters.Count(Timing::EVALUATE);
+    std::vector<double> v(1 << 16, 1.0);
+    volatile double sum = 0.0;
+    for(double d : v) {sum = sum + d;}
+  }
+
+  REQUIRE(counters.GetCalls(Timing::EVALUATE) == (good ? 3 : 0));
+  if(good && counters.Has(Counters::INSTRUCTIONS)) {REQUIRE(0 < counters.GetTotal(Timing::EVALUATE)[Counters::INSTRUCTIONS]);}
+}
+
+TEST_CASE("Counters file", "[counters]")
+{
+  Counters counters;
+  counters.Open();
+  {Counters::Sample sample = counters.Count(Timing::SELECTOR);}
+  counters.Write("counters-test.csv", 4, 2);
+
+  std::ifstream is("counters-test.csv");
+  std::string line;
+  REQUIRE(std::getline(is, line));
+  REQUIRE(line == "selection,diagnostic,phase,calls,cycles,instructions,l1d_misses,llc_misses,branch_misses,ipc,l1d_mpki,llc_mpki");
+
+  // one row per counted phase
+  if(counters.Good())
+  {
+    REQUIRE(std::getline(is, line));
+    REQUIRE(line.rfind("4,2,selector,1,", 0) == 0);
+  }
+  REQUIRE(!std::getline(is, line));
+
+  std::remove("counters-test.csv");
+}
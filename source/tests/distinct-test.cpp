@@ -0,0 +1,81 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/distinct.h"
+
+// empirical headers
+#include "base/vector.h"
+#include "tools/Random.h"
+
+// library includes
+#include <limits>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ distinct-test.cpp -o distinct-test; ./distinct-test
+
+TEST_CASE("Distinct groups", "[add]")
+{
+  emp::vector<emp::vector<double>> vecs = {{1.0, 2.0}, {0.0, 2.0}, {1.0, 2.0}, {-0.0, 2.0}, {2.0, 1.0}, {0.0, 2.0}};
+
+  Distinct groups;
+  REQUIRE(groups.Add(vecs[0], 0) == 0);
+  REQUIRE(groups.Add(vecs[1], 1) == 1);
+  REQUIRE(groups.Add(vecs[2], 2) == 0);
+  // -0.0 == 0.0, just like the old Pnorm comparison
+  REQUIRE(groups.Add(vecs[3], 3) == 1);
+  REQUIRE(groups.Add(vecs[4], 4) == 2);
+  REQUIRE(groups.Add(vecs[5], 5) == 1);
+
+  REQUIRE(groups.GetCount() == 3);
+  REQUIRE(groups.GetSize(0) == 2);
+  REQUIRE(groups.GetSize(1) == 3);
+  REQUIRE(groups.GetLargest() == 1);
+  REQUIRE(groups.GetFirst(1) == 1);
+
+  // NaN never matches, not even itself
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  emp::vector<double> odd = {nan, 2.0};
+  REQUIRE(groups.Add(odd, 6) == 3);
+  REQUIRE(groups.Add(odd, 7) == 4);
+}
+
+TEST_CASE("Distinct ties and clearing", "[add][clear]")
+{
+  emp::vector<emp::vector<double>> vecs = {{3.0}, {1.0}, {1.0}, {3.0}};
+
+  Distinct groups;
+  for(size_t i = 0; i < vecs.size(); ++i) {groups.Add(vecs[i], i);}
+
+  // tied groups go to the one seen first
+  REQUIRE(groups.GetLargest() == 0);
+  REQUIRE(groups.GetFirst(groups.GetLargest()) == 0);
+
+  groups.Clear();
+  REQUIRE(groups.GetCount() == 0);
+  REQUIRE(groups.Add(vecs[1], 0) == 0);
+  REQUIRE(groups.Add(vecs[0], 1) == 1);
+}
+
+TEST_CASE("Distinct matches pairwise comparison", "[add]")
+{
+  // many small vectors over a few values, so there are plenty of duplicates and the table grows
+  emp::Random random(7);
+  emp::vector<emp::vector<double>> vecs(500);
+  for(auto & v : vecs)
+  {
+    v.resize(3);
+    for(auto & x : v) {x = static_cast<double>(random.GetUInt(3));}
+  }
+
+  Distinct groups;
+  emp::vector<size_t> ids;
+  for(size_t i = 0; i < vecs.size(); ++i) {ids.push_back(groups.Add(vecs[i], i));}
+
+  REQUIRE(groups.GetCount() == 27);
+  for(size_t i = 0; i < vecs.size(); ++i)
+  {
+    REQUIRE(vecs[groups.GetFirst(ids[i])] == vecs[i]);
+    for(size_t j = 0; j < i; ++j) {REQUIRE((ids[i] == ids[j]) == (vecs[i] == vecs[j]));}
+  }
+}
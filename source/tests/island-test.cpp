@@ -0,0 +1,136 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/island.h"
+
+// library includes
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -pthread -I ../../../Empirical/source/ island-test.cpp -o island-test; ./island-test
+
+// const vars for test
+constexpr size_t ITEMS = 100000;
+
+TEST_CASE("SpscQueue bounds", "[queue]")
+{
+  SpscQueue<size_t, 4> queue;
+  size_t item = 0;
+
+  // empty queue has nothing to pop
+  REQUIRE(!queue.Pop(item));
+
+  // full queue refuses pushes
+  for(size_t i = 0; i < 4; ++i) {REQUIRE(queue.Push(size_t(i)));}
+  REQUIRE(!queue.Push(size_t(4)));
+
+  // items come out in order
+  for(size_t i = 0; i < 4; ++i) {REQUIRE(queue.Pop(item)); REQUIRE(item == i);}
+  REQUIRE(!queue.Pop(item));
+}
+
+TEST_CASE("SpscQueue across threads", "[queue]")
+{
+  SpscQueue<size_t, 8> queue;
+
+  std::thread producer([&queue]()
+  {
+    for(size_t i = 0; i < ITEMS; ++i)
+    {
+      while(!queue.Push(size_t(i))) {std::this_thread::yield();}
+    }
+  });
+
+  // every item arrives exactly once and in order
+  bool ordered = true;
+  for(size_t i = 0; i < ITEMS; ++i)
+  {
+    size_t item = 0;
+    while(!queue.Pop(item)) {std::this_thread::yield();}
+    ordered = ordered && (item == i);
+  }
+  producer.join();
+
+  REQUIRE(ordered);
+}
+
+TEST_CASE("Termination criteria stop every island at one generation", "[termination]")
+{
+  const std::string dir = "island-test-data/";
+
+  DiaConfig config;
+  config.ISLANDS(3);
+  config.POP_SIZE(64);
+  config.OBJECTIVE_CNT(5);
+  config.TARGET(5.0);
+  config.MU(8);
+  config.MUTATE_PER(0.2);
+  config.SEED(11);
+  config.MAX_GENS(400);
+  config.STOP_OPTIMIZED(true);
+  config.LOG_LEVEL(0);
+  config.OUTPUT_DIR(dir);
+
+  IslandModel model(config);
+  model.Run();
+
+  // one common last generation, well before MAX_GENS
+  const size_t last = model.GetWorld(0).GetCensus().update;
+  REQUIRE(last < config.MAX_GENS());
+
+  // every island either met the criterion itself (no later than the common generation) or stopped because another one did
+  size_t optimized = 0;
+  for(size_t k = 0; k < model.GetSize(); ++k)
+  {
+    DiagWorld & world = model.GetWorld(k);
+    REQUIRE(world.GetCensus().update == last);
+    if(world.GetStopReason() == "optimized") {++optimized;}
+    else {REQUIRE(world.GetStopReason().rfind("island_", 0) == 0);}
+
+    // termination.csv is written once, for the generation the island stopped at
+    std::ifstream is(dir + "island_" + std::to_string(k) + "/termination.csv");
+    std::string header, row, extra;
+    REQUIRE(std::getline(is, header));
+    REQUIRE(std::getline(is, row));
+    REQUIRE(!std::getline(is, extra));
+    REQUIRE(std::stoul(row.substr(0, row.find(','))) <= last);
+  }
+  REQUIRE(0 < optimized);
+
+  std::filesystem::remove_all(dir);
+}
+
+// last case, the caught signal stays caught for the rest of the process
+TEST_CASE("Signals stop every island at one generation", "[signal]")
+{
+  const std::string dir = "island-test-data/";
+
+  DiaConfig config;
+  config.ISLANDS(3);
+  config.POP_SIZE(32);
+  config.OBJECTIVE_CNT(10);
+  config.MU(4);
+  config.MAX_GENS(1000);
+  config.MIGRATE_INTERVAL(1);
+  config.LOG_LEVEL(0);
+  config.OUTPUT_DIR(dir);
+
+  IslandModel model(config);
+
+  // caught before any island starts, so the first one to look stops everyone after gen 1
+  Termination::CatchSignals();
+  std::raise(SIGTERM);
+  model.Run();
+
+  std::filesystem::remove_all(dir);
+  for(size_t k = 0; k < model.GetSize(); ++k)
+  {
+    REQUIRE(model.GetWorld(k).GetCensus().update == 1);
+    REQUIRE(model.GetWorld(k).GetStopReason() == "signal");
+  }
+}
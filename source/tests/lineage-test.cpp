@@ -0,0 +1,134 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/lineage.h"
+
+// library includes
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ lineage-test.cpp -o lineage-test; ./lineage-test
+
+std::string ReadAll(const std::string & path)
+{
+  std::ifstream is(path);
+  return std::string((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+}
+
+auto NoClones = [](size_t) {return false;};
+
+TEST_CASE("Extinct lineages are pruned and unbranching ancestors folded", "[lineage]")
+{
+  {
+    Lineage lineage("lineage-test.csv", 4, false);
+    lineage.Found(0);
+    REQUIRE(lineage.GetTaxa() == 4);
+    REQUIRE(lineage.GetNodes() == 4);
+    REQUIRE(lineage.GetRoots() == 4);
+    REQUIRE(lineage.GetDiversity() == 3);
+
+    // every offspring from id 0: the other founders die out
+    lineage.Birth({0, 0, 0, 0}, NoClones, 0);
+    REQUIRE(lineage.GetTaxa() == 4);
+    REQUIRE(lineage.GetNodes() == 5);
+    REQUIRE(lineage.GetRoots() == 1);
+    REQUIRE(lineage.GetDiversity() == 4);
+
+    // clones stay in their parent's taxon
+    lineage.Birth({0, 1, 2, 3}, [](size_t) {return true;}, 1);
+    REQUIRE(lineage.GetTaxa() == 4);
+    REQUIRE(lineage.GetNodes() == 5);
+
+    // two clones and two children of id 1: the root stops branching and is folded into id 1's taxon
+    const Lineage::id_t kept = lineage.GetTaxon(1);
+    lineage.Birth({1, 1, 1, 1}, [](size_t i) {return i < 2;}, 2);
+    REQUIRE(lineage.GetTaxon(0) == kept);
+    REQUIRE(lineage.GetTaxa() == 3);
+    REQUIRE(lineage.GetNodes() == 3);
+    REQUIRE(lineage.GetRoots() == 1);
+    REQUIRE(lineage.GetDiversity() == 3);
+    REQUIRE(lineage.GetNode(kept).span == 2);
+    REQUIRE(lineage.GetNode(kept).parent == Lineage::NONE);
+    lineage.Row(3);
+
+    // an immigrant starts a second root
+    lineage.Arrive(3, 3);
+    REQUIRE(lineage.GetRoots() == 2);
+    lineage.Row(4);
+  }
+
+  // most recent common ancestor is the folded root: born at 1, one taxon below the founder
+  const std::string csv = ReadAll("lineage-test.csv");
+  REQUIRE(csv == "gen,taxa,nodes,roots,diversity,mrca_gen,mrca_depth,mean_depth,entropy\n"
+                 "3,3,3,1,3,1,1,1.5,1.03972\n"
+                 "4,3,3,2,3,NA,NA,1,1.03972\n");
+
+  std::remove("lineage-test.csv");
+}
+
+TEST_CASE("Table stays bounded by the population", "[lineage]")
+{
+  const size_t pop = 64;
+  Lineage lineage("lineage-test.csv", pop, false);
+  lineage.Found(0);
+
+  std::mt19937_64 rng(7);
+  emp::vector<size_t> parents(pop);
+  size_t most = 0;
+  for(size_t gen = 0; gen < 5000; ++gen)
+  {
+    for(auto & p : parents) {p = rng() % pop;}
+    lineage.Birth(parents, [&rng](size_t) {return rng() % 4 == 0;}, gen);
+    most = std::max(most, lineage.GetNodes());
+  }
+
+  // every kept ancestor branches, so there are fewer than two nodes per position id
+  REQUIRE(most < 2 * pop);
+  REQUIRE(lineage.GetRoots() == 1);
+  REQUIRE(1000 < lineage.GetDiversity());
+
+  std::remove("lineage-test.csv");
+}
+
+TEST_CASE("Checkpointed tables carry on the same", "[lineage]")
+{
+  const size_t pop = 16;
+  std::mt19937_64 rng(11);
+  emp::vector<size_t> parents(pop);
+  emp::vector<double> score(3, 1.0);
+
+  Lineage a("lineage-test-a.csv", pop, true);
+  a.Found(0);
+  for(size_t gen = 0; gen < 50; ++gen)
+  {
+    for(size_t i = 0; i < pop; ++i) {a.Record(i, static_cast<double>(gen), score);}
+    for(auto & p : parents) {p = rng() % pop;}
+    a.Birth(parents, NoClones, gen);
+  }
+
+  std::stringstream state;
+  a.Save(state);
+  Lineage b("lineage-test-b.csv", pop, true);
+  REQUIRE(b.Load(state));
+  REQUIRE(b.GetTaxa() == a.GetTaxa());
+  REQUIRE(b.GetNodes() == a.GetNodes());
+  REQUIRE(b.GetDiversity() == a.GetDiversity());
+
+  for(auto & p : parents) {p = rng() % pop;}
+  a.Birth(parents, NoClones, 50); b.Birth(parents, NoClones, 50);
+  a.Snapshot("lineage-test-a.csv"); b.Snapshot("lineage-test-b.csv");
+  REQUIRE(ReadAll("lineage-test-a.csv") == ReadAll("lineage-test-b.csv"));
+
+  // a table kept with score vectors only fits a tracker keeping them too
+  std::stringstream again;
+  a.Save(again);
+  Lineage c("lineage-test-c.csv", pop, false);
+  REQUIRE(!c.Load(again));
+
+  std::remove("lineage-test-a.csv"); std::remove("lineage-test-b.csv"); std::remove("lineage-test-c.csv");
+}
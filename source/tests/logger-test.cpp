@@ -0,0 +1,96 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/logger.h"
+
+// library includes
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ logger-test.cpp -o logger-test; ./logger-test
+
+TEST_CASE("Levels and buffering", "[text]")
+{
+  std::ostringstream os;
+  {
+    Logger logger(os, Logger::INFO);
+    logger.Info() << "Setting things up..." << std::endl;
+    logger.Debug() << "Created emp::Ptr" << std::endl;
+
+    // held until the buffer fills, a second passes or the logger flushes
+    REQUIRE(os.str().empty());
+
+    // problems go out right away, along with everything held before them
+    logger.Error() << "ERROR: SOMETHING BROKE" << std::endl;
+    REQUIRE(os.str() == "Setting things up...\nERROR: SOMETHING BROKE\n");
+
+    logger.Info() << "one " << 1 << "\n" << "two" << std::endl;
+  }
+  // the rest is written when the logger goes away
+  REQUIRE(os.str() == "Setting things up...\nERROR: SOMETHING BROKE\none 1\ntwo\n");
+
+  std::ostringstream quiet;
+  Logger logger(quiet, Logger::ERROR, 0);
+  logger.Warn() << "not printed" << std::endl;
+  logger.Error() << "printed" << std::endl;
+  REQUIRE(quiet.str() == "printed\n");
+}
+
+TEST_CASE("Records as text and JSON", "[record]")
+{
+  std::ostringstream os;
+  Logger logger(os, Logger::INFO, 0);
+
+  logger.Write(Logger::INFO, Logger::Record().Add("gen", size_t(5)).Add("max_fit", 1.5).Add("max_opt", 2));
+  logger.Write(Logger::INFO, Logger::Record("Stopped at gen=5: signal").Add("gen", size_t(5)).Add("stop", std::string("signal")));
+  REQUIRE(os.str() == "gen=5, max_fit=1.5, max_opt=2\nStopped at gen=5: signal\n");
+
+  std::ostringstream js;
+  Logger json(js, Logger::INFO, 0, true);
+  json.Write(Logger::INFO, Logger::Record().Add("gen", 7).Add("fit", std::numeric_limits<double>::infinity()));
+  json.Info() << "say \"hi\"" << std::endl;
+  json.Info() << std::endl;
+
+  std::istringstream is(js.str());
+  std::string line;
+  REQUIRE(std::getline(is, line));
+  REQUIRE(line.rfind("{\"time\":", 0) == 0);
+  REQUIRE(line.find(",\"level\":\"info\",\"gen\":7,\"fit\":null}") != std::string::npos);
+  REQUIRE(std::getline(is, line));
+  REQUIRE(line.find(",\"msg\":\"say \\\"hi\\\"\"}") != std::string::npos);
+  // blank lines are dropped
+  REQUIRE(!std::getline(is, line));
+}
+
+TEST_CASE("Rate limit", "[rate]")
+{
+  std::ostringstream os;
+  Logger logger(os);
+
+  REQUIRE(logger.Due(0.0));
+  REQUIRE(logger.Due(0.0));
+
+  REQUIRE(logger.Due(1000.0));
+  REQUIRE(!logger.Due(1000.0));
+  REQUIRE(!logger.Due(1000.0));
+}
+
+TEST_CASE("Timed flush", "[tick]")
+{
+  std::ostringstream os;
+  Logger logger(os, Logger::INFO);
+  logger.Info() << "gen=10" << std::endl;
+
+  // a fresh line stays held
+  logger.Tick();
+  REQUIRE(os.str().empty());
+
+  // and goes out on the first tick a second later, with no new line needed
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  logger.Tick();
+  REQUIRE(os.str() == "gen=10\n");
+}
@@ -0,0 +1,105 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/metrics.h"
+
+// empirical headers
+#include "base/vector.h"
+
+// library includes
+#include <memory>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ metrics-test.cpp -o metrics-test; ./metrics-test
+
+// four orgs over three objectives, orgs 1 and 3 share a genome and score vector
+Census MakeCensus()
+{
+  Census census;
+  census.update = 10;
+  census.agg = {1.0, 3.0, 2.0, 3.0};
+  census.count = {0, 1, 2, 1};
+  census.start = {0, 2, 2, 0};
+  census.parents = {1, 1, 3, 2};
+
+  emp::vector<Org::genome_t> genomes = {{1.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, {0.0, 1.0, 1.0}, {1.0, 1.0, 1.0}};
+  emp::vector<Org::optimal_t> optimal = {{false, false, false}, {true, false, false}, {false, true, true}, {true, false, false}};
+  for(size_t i = 0; i < genomes.size(); ++i)
+  {
+    census.genome.push_back(std::make_shared<const Org::genome_t>(genomes[i]));
+    census.score.push_back(std::make_shared<const Org::score_t>(genomes[i]));
+    census.optimal.push_back(std::make_shared<const Org::optimal_t>(optimal[i]));
+  }
+
+  return census;
+}
+
+TEST_CASE("Metrics positions only", "[compute]")
+{
+  Census census = MakeCensus();
+
+  Metrics metrics;
+  metrics.Compute(census, Metrics::BEST);
+  REQUIRE(metrics.GetDone() == Metrics::BEST);
+
+  // first of the tied elites, first with the largest count
+  REQUIRE(metrics.GetElite() == 1);
+  REQUIRE(metrics.GetOptimized() == 2);
+
+  // nothing else was touched
+  REQUIRE(metrics.PopFit().GetCount() == 0);
+}
+
+TEST_CASE("Metrics full row", "[compute]")
+{
+  Census census = MakeCensus();
+
+  Metrics metrics;
+  metrics.Compute(census, Metrics::UNIQUE);
+  REQUIRE(metrics.GetUniqueObjective() == 3);
+
+  // only the missing groups are added
+  metrics.Compute(census, Metrics::ROW);
+  REQUIRE(metrics.GetDone() == Metrics::ROW);
+  REQUIRE(metrics.GetUniqueObjective() == 3);
+  REQUIRE(metrics.GetElite() == 1);
+
+  REQUIRE(metrics.GetCommon() == 1);
+  REQUIRE(metrics.GetCommonCount() == 2);
+  REQUIRE(metrics.GetUniqueGenotype() == 3);
+  REQUIRE(metrics.GetUniquePhenotype() == 3);
+  REQUIRE(metrics.GetUniqueStart() == 2);
+  REQUIRE(metrics.GetUniqueParent() == 3);
+
+  REQUIRE(metrics.PopFit().GetCount() == 4);
+  REQUIRE(metrics.PopFit().GetMean() == 2.25);
+  REQUIRE(metrics.PntFit().GetMean() == 2.75);
+  REQUIRE(metrics.PntOpti().GetMax() == 2);
+}
+
+TEST_CASE("Metrics clear between censuses", "[clear]")
+{
+  Census census = MakeCensus();
+
+  Metrics metrics;
+  metrics.Compute(census, Metrics::ROW);
+
+  // next generation everyone is the same
+  census.start = {1, 1, 1, 1};
+  census.parents = {0, 0, 0, 0};
+  for(auto & g : census.genome) {g = census.genome[0];}
+  for(auto & s : census.score) {s = census.score[0];}
+  for(auto & o : census.optimal) {o = census.optimal[0];}
+
+  metrics.Clear();
+  REQUIRE(metrics.GetDone() == Metrics::NONE);
+
+  metrics.Compute(census, Metrics::ROW);
+  REQUIRE(metrics.GetUniqueObjective() == 0);
+  REQUIRE(metrics.GetUniqueStart() == 1);
+  REQUIRE(metrics.GetUniqueParent() == 1);
+  REQUIRE(metrics.GetUniqueGenotype() == 1);
+  REQUIRE(metrics.GetCommonCount() == 4);
+  REQUIRE(metrics.PopFit().GetCount() == 4);
+}
@@ -0,0 +1,166 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/mutation.h"
+
+// empirical headers
+#include "base/vector.h"
+#include "tools/Random.h"
+
+// library includes
+#include <algorithm>
+#include <cmath>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ mutation-test.cpp -o mutation-test; ./mutation-test
+
+// const vars for test
+constexpr size_t SEED = 17;
+constexpr size_t M = 100;
+constexpr double TARGET = 100.0;
+constexpr size_t RUNS = 20000;
+
+TEST_CASE("Bound function", "[bound]")
+{
+  emp::Ptr<emp::Random> random = emp::NewPtr<emp::Random>(SEED);
+  Mutation mutation(random);
+
+  // simple addition inside of bounds
+  REQUIRE(mutation.Bound(50.0, 1.5, TARGET) == 51.5);
+  REQUIRE(mutation.Bound(50.0, -1.5, TARGET) == 48.5);
+
+  // going over the target wraps around it
+  REQUIRE(mutation.Bound(99.0, 3.0, TARGET) == 98.0);
+  REQUIRE(mutation.Bound(100.0, 0.0, TARGET) == 100.0);
+
+  // going into the negatives clamps at zero
+  REQUIRE(mutation.Bound(1.0, -3.0, TARGET) == 0.0);
+
+  random.Delete();
+}
+
+TEST_CASE("Skip and per gene mutations agree", "[skip]")
+{
+  emp::Ptr<emp::Random> random = emp::NewPtr<emp::Random>(SEED);
+  Mutation mutation(random);
+  const emp::vector<double> target(M, TARGET);
+  const emp::vector<double> start(M, 50.0);
+
+  for(double rate : {0.007, 0.05, 0.5})
+  {
+    // mutation counts and per gene hit counts for both operators
+    double skip_tot = 0.0; double gene_tot = 0.0;
+    emp::vector<size_t> skip_hits(M, 0); emp::vector<size_t> gene_hits(M, 0);
+
+    for(size_t r = 0; r < RUNS; ++r)
+    {
+      Org a(start); Org b(start);
+      skip_tot += mutation.Skip(a, target, rate, 0.0, 1.0);
+      gene_tot += mutation.PerGene(b, target, rate, 0.0, 1.0);
+
+      for(size_t i = 0; i < M; ++i)
+      {
+        skip_hits[i] += (a.GetGenome()[i] != 50.0);
+        gene_hits[i] += (b.GetGenome()[i] != 50.0);
+      }
+    }
+
+    // average number of mutations should be M * rate for both (within 5 standard errors)
+    const double expected = static_cast<double>(M) * rate;
+    const double err = 5.0 * std::sqrt(expected * (1.0 - rate) / static_cast<double>(RUNS));
+    REQUIRE(std::abs(skip_tot / RUNS - expected) < err);
+    REQUIRE(std::abs(gene_tot / RUNS - expected) < err);
+
+    // first and last genes should be hit just as often as any other gene
+    const double per_gene = static_cast<double>(RUNS) * rate;
+    const double gene_err = 5.0 * std::sqrt(per_gene * (1.0 - rate));
+    REQUIRE(std::abs(skip_hits.front() - per_gene) < gene_err);
+    REQUIRE(std::abs(skip_hits.back() - per_gene) < gene_err);
+  }
+
+  random.Delete();
+}
+
+TEST_CASE("Skip mutation edge cases", "[skip]")
+{
+  emp::Ptr<emp::Random> random = emp::NewPtr<emp::Random>(SEED);
+  Mutation mutation(random);
+  const emp::vector<double> target(M, TARGET);
+  const emp::vector<double> start(M, 50.0);
+
+  // nothing mutates, so offspring keeps sharing its parent's genome
+  Org parent(start);
+  Org a(parent);
+  REQUIRE(mutation.Skip(a, target, 0.0, 0.0, 1.0) == 0);
+  REQUIRE(a.SharedGenome());
+
+  // everything mutates
+  Org b(parent);
+  REQUIRE(mutation.Skip(b, target, 1.0, 0.0, 1.0) == M);
+  REQUIRE(!b.SharedGenome());
+  REQUIRE_THAT(parent.GetGenome(), Catch::Matchers::Equals(start));
+
+  // mutated genes always stay inside [0, target]
+  Org c(emp::vector<double>(M, TARGET));
+  mutation.Skip(c, target, 0.5, 0.0, 10.0);
+  REQUIRE(std::all_of(c.GetGenome().begin(), c.GetGenome().end(), [](double g) {return 0.0 <= g && g <= TARGET;}));
+
+  random.Delete();
+}
+
+TEST_CASE("Stream mutations draw in bulk", "[stream]")
+{
+  emp::Ptr<emp::Random> random = emp::NewPtr<emp::Random>(SEED);
+  emp::Ptr<Stream> stream = emp::NewPtr<Stream>(SEED);
+  Mutation mutation(random);
+  mutation.SetStream(stream);
+  const emp::vector<double> target(M, TARGET);
+  const emp::vector<double> start(M, 50.0);
+
+  for(double rate : {0.007, 0.05, 0.5})
+  {
+    for(size_t id = 0; id < 50; ++id)
+    {
+      // bulk buffers give the same genome as one coin flip and one normal per gene
+      stream->Key(1, Stream::MUTATION, id);
+      Org a(start);
+      const size_t mcnt = mutation.PerGene(a, target, rate, 0.0, 1.0);
+
+      Stream single(SEED);
+      single.Key(1, Stream::MUTATION, id);
+      emp::vector<double> want = start;
+      size_t want_cnt = 0;
+      for(size_t i = 0; i < M; ++i)
+      {
+        if(single.P(rate)) {want[i] = mutation.Bound(want[i], single.GetRandNormal(0.0, 1.0), target[i]); ++want_cnt;}
+      }
+
+      REQUIRE(mcnt == want_cnt);
+      REQUIRE_THAT(a.GetGenome(), Catch::Matchers::Equals(want));
+
+      // skip walks the gaps first, then draws its mutations in bulk, still matching gap by gap draws
+      const double log_q = std::log1p(-rate);
+      auto gap = [&single, log_q]() {return static_cast<size_t>(std::floor(std::log(1.0 - single.GetDouble()) / log_q));};
+
+      stream->Key(2, Stream::MUTATION, id);
+      Org b(start);
+      const size_t skip_cnt = mutation.Skip(b, target, rate, 0.0, 1.0);
+
+      single.Key(2, Stream::MUTATION, id);
+      want = start;
+      want_cnt = 0;
+      for(size_t i = gap(); i < M; i += gap() + 1)
+      {
+        want[i] = mutation.Bound(want[i], single.GetRandNormal(0.0, 1.0), target[i]);
+        ++want_cnt;
+      }
+
+      REQUIRE(skip_cnt == want_cnt);
+      REQUIRE_THAT(b.GetGenome(), Catch::Matchers::Equals(want));
+    }
+  }
+
+  stream.Delete();
+  random.Delete();
+}
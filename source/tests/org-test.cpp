@@ -172,7 +172,7 @@ TEST_CASE("Simulating birth offspring", "[birth]")
   REQUIRE(!z.GetClone());
 
   // inherit stuff for y and check if correctly set
-  y.Inherit(b.GetScore(), b.GetOptimal(), b.GetCount(), b.GetAggregate());
+  y.Inherit(b.GetScore(), b.GetOptimal(), b.GetCount(), b.GetAggregate(), b.StartPosition());
 
   REQUIRE_THAT(y.GetScore(), Catch::Matchers::Equals(x10));
   REQUIRE(y.GetScored());
@@ -183,4 +183,46 @@ TEST_CASE("Simulating birth offspring", "[birth]")
   REQUIRE(y.GetAggregate() == 55.0);
   REQUIRE(y.GetAggregated());
   REQUIRE(y.GetClone());
+}
+
+TEST_CASE("Copy on write functions", "[cow]")
+{
+  // initialize vars needed for orgs
+  emp::vector<double> x10{1.0,2.0,3.0,4.0,5.0,6.0,7.0,8.0,9.0,10.0};
+  emp::vector<double> m10{1.0,2.0,3.0,4.0,5.5,6.0,7.0,8.0,9.0,10.0};
+  emp::vector<bool> bx10{false,false,true,true,false,true,false,true,false,true};
+
+  // create parent org and score it
+  Org a(x10);
+  a.SetScore(x10); a.SetOptimal(bx10);
+  a.AggregateScore(); a.CountOptimized();
+
+  // copies share everything with the parent
+  Org b(a); Org c(a);
+  REQUIRE(a.SharedGenome());
+  REQUIRE(&a.GetGenome() == &b.GetGenome());
+  REQUIRE(&a.GetScore() == &b.GetScore());
+  REQUIRE(&a.GetOptimal() == &c.GetOptimal());
+
+  // b is a clone and keeps its parent's phenotype
+  b.MeClone();
+  REQUIRE(b.GetClone());
+  REQUIRE(b.GetAggregate() == 55.0);
+  REQUIRE(b.GetCount() == 5);
+
+  // c gets mutated, which should not touch a or b
+  c.EditGenome()[4] = 5.5;
+  c.Reset();
+  REQUIRE_THAT(c.GetGenome(), Catch::Matchers::Equals(m10));
+  REQUIRE_THAT(a.GetGenome(), Catch::Matchers::Equals(x10));
+  REQUIRE_THAT(b.GetGenome(), Catch::Matchers::Equals(x10));
+  REQUIRE(&a.GetGenome() != &c.GetGenome());
+  REQUIRE(!c.SharedGenome());
+  REQUIRE(!c.GetScored());
+  REQUIRE_THAT(a.GetScore(), Catch::Matchers::Equals(x10));
+
+  // writing to an unshared genome does not copy it
+  const double * before = c.GetGenome().data();
+  c.EditGenome()[0] = 0.5;
+  REQUIRE(before == c.GetGenome().data());
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/pipe.h"
+
+// empirical headers
+#include "base/vector.h"
+
+// library includes
+#include <thread>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -pthread -I ../../../Empirical/source/ pipe-test.cpp -o pipe-test; ./pipe-test
+
+TEST_CASE("Pipe runs jobs in order", "[order]")
+{
+  emp::vector<size_t> seen;
+
+  {
+    Pipe pipe;
+    for(size_t i = 0; i < 100; ++i) {pipe.Submit([&seen, i]() {seen.push_back(i);});}
+  }
+
+  // destructor finishes the last job before joining
+  REQUIRE(seen.size() == 100);
+  for(size_t i = 0; i < seen.size(); ++i) {REQUIRE(seen[i] == i);}
+}
+
+TEST_CASE("Pipe wait", "[wait]")
+{
+  Pipe pipe;
+  size_t value = 0;
+
+  // job in flight is done once wait returns
+  pipe.Submit([&value]() {std::this_thread::sleep_for(std::chrono::milliseconds(20)); value = 7;});
+  pipe.Wait();
+  REQUIRE(value == 7);
+
+  // waiting on an idle pipe returns right away
+  pipe.Wait();
+  REQUIRE(value == 7);
+}
@@ -0,0 +1,81 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/pool.h"
+
+// empirical headers
+#include "base/vector.h"
+
+// library includes
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -pthread -I ../../../Empirical/source/ pool-test.cpp -o pool-test; ./pool-test
+
+TEST_CASE("Pool chunks", "[chunks]")
+{
+  Pool pool(4);
+  REQUIRE(pool.GetSize() == 4);
+
+  // chunks cover every slot exactly once, in order
+  REQUIRE(pool.ChunkStart(10, 0) == 0);
+  REQUIRE(pool.ChunkStart(10, 4) == 10);
+  for(size_t w = 0; w < 4; ++w) {REQUIRE(pool.ChunkStart(10, w) <= pool.ChunkStart(10, w + 1));}
+}
+
+TEST_CASE("Pool parallel for", "[parallel]")
+{
+  for(size_t threads : {1, 2, 3, 8})
+  {
+    Pool pool(threads);
+
+    // run a few rounds with more and fewer slots than workers
+    for(size_t n : {0, 1, 5, 1000})
+    {
+      emp::vector<size_t> hits(n, 0);
+      emp::vector<size_t> owner(n, threads);
+
+      pool.ParallelFor(n, [&hits, &owner](const size_t begin, const size_t end, const size_t worker)
+      {
+        for(size_t i = begin; i < end; ++i) {++hits[i]; owner[i] = worker;}
+      });
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        REQUIRE(hits[i] == 1);
+        REQUIRE(pool.ChunkStart(n, owner[i]) <= i);
+        REQUIRE(i < pool.ChunkStart(n, owner[i] + 1));
+      }
+    }
+  }
+}
+
+TEST_CASE("TaskPool runs every task once", "[tasks]")
+{
+  for(size_t threads : {1, 2, 5})
+  {
+    TaskPool pool(threads);
+    REQUIRE(pool.GetSize() == threads);
+
+    // uneven tasks so idle workers have something to steal
+    std::vector<std::atomic<size_t>> hits(40);
+    for(size_t i = 0; i < hits.size(); ++i)
+    {
+      pool.Submit([&hits, i]()
+      {
+        if(i % 7 == 0) {std::this_thread::sleep_for(std::chrono::milliseconds(5));}
+        ++hits[i];
+      });
+    }
+    pool.Run();
+
+    for(auto & h : hits) {REQUIRE(h == 1);}
+
+    // running again with nothing queued returns right away
+    pool.Run();
+  }
+}
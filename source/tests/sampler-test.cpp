@@ -0,0 +1,119 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/sampler.h"
+
+// library includes
+#include <string>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ sampler-test.cpp -o sampler-test; ./sampler-test
+
+size_t CountRows(const Sampler & sampler, const size_t gens)
+{
+  size_t rows = 0;
+  for(size_t g = 0; g <= gens; ++g) {rows += sampler.Scheduled(g);}
+  return rows;
+}
+
+TEST_CASE("Fixed interval", "[sampler]")
+{
+  DiaConfig config;
+  config.DATA_INTERVAL(10);
+  config.MAX_GENS(95);
+
+  std::string err;
+  REQUIRE(Sampler::Check(config, err));
+
+  Sampler sampler(config);
+  REQUIRE(sampler.Scheduled(0));
+  REQUIRE(!sampler.Scheduled(5));
+  REQUIRE(sampler.Scheduled(90));
+  // the last generation always gets a row
+  REQUIRE(sampler.Scheduled(95));
+  REQUIRE(CountRows(sampler, 95) == 11);
+  REQUIRE(!sampler.WatchesEvents());
+}
+
+TEST_CASE("Log spaced", "[sampler]")
+{
+  DiaConfig config;
+  config.DATA_SAMPLING(Sampler::LOG);
+  config.DATA_PER_DECADE(20);
+  config.MAX_GENS(10000000);
+  Sampler sampler(config);
+
+  // every generation early on
+  for(size_t g = 0; g <= 8; ++g) {REQUIRE(sampler.Scheduled(g));}
+
+  // about DATA_PER_DECADE rows per power of ten, instead of a million at DATA_INTERVAL 10
+  const size_t rows = CountRows(sampler, config.MAX_GENS());
+  REQUIRE(100 < rows);
+  REQUIRE(rows < 200);
+
+  size_t decade = 0;
+  for(size_t g = 1000000; g < 10000000; ++g) {decade += sampler.Scheduled(g);}
+  REQUIRE(decade == 20);
+}
+
+TEST_CASE("Dense then sparse", "[sampler]")
+{
+  DiaConfig config;
+  config.DATA_SAMPLING(Sampler::DENSE);
+  config.DATA_INTERVAL(10);
+  config.DATA_DENSE_GENS(1000);
+  config.DATA_SPARSE_INTERVAL(1000);
+  config.MAX_GENS(100000);
+  Sampler sampler(config);
+
+  REQUIRE(sampler.Scheduled(990));
+  REQUIRE(sampler.Scheduled(1000));
+  REQUIRE(!sampler.Scheduled(1010));
+  REQUIRE(sampler.Scheduled(2000));
+  REQUIRE(CountRows(sampler, config.MAX_GENS()) == 101 + 99);
+}
+
+TEST_CASE("Events", "[sampler]")
+{
+  DiaConfig config;
+  config.DATA_SAMPLING(Sampler::EVENTS);
+  config.DATA_SPARSE_INTERVAL(100);
+  config.MAX_GENS(1000);
+  Sampler sampler(config);
+  REQUIRE(sampler.WatchesEvents());
+  REQUIRE(!sampler.Scheduled(50));
+  REQUIRE(sampler.Scheduled(100));
+
+  // the first generation counts, then only changes do
+  REQUIRE(sampler.Changed(0, 0));
+  REQUIRE(!sampler.Changed(0, 0));
+  REQUIRE(sampler.Changed(1, 0));
+  REQUIRE(sampler.Changed(1, 2));
+  REQUIRE(!sampler.Changed(1, 2));
+
+  // a checkpointed watch carries on where it was
+  bool seen = false; uint64_t opt = 0, uni = 0;
+  sampler.GetState(seen, opt, uni);
+  Sampler resumed(config);
+  resumed.SetState(seen, opt, uni);
+  REQUIRE(!resumed.Changed(1, 2));
+}
+
+TEST_CASE("Bad settings", "[sampler]")
+{
+  DiaConfig config;
+  std::string err;
+
+  config.DATA_SAMPLING(Sampler::POLICIES);
+  REQUIRE(!Sampler::Check(config, err));
+
+  config.DATA_SAMPLING(Sampler::FIXED);
+  config.DATA_INTERVAL(0);
+  REQUIRE(!Sampler::Check(config, err));
+  REQUIRE(err == "DATA_INTERVAL 0 is used as 1");
+
+  // used as 1
+  Sampler sampler(config);
+  REQUIRE(CountRows(sampler, 10) == 11);
+}
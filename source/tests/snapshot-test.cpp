@@ -0,0 +1,95 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/snapshot.h"
+
+// library includes
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ snapshot-test.cpp -o snapshot-test; ./snapshot-test
+
+// const vars for test
+constexpr size_t POP = 10;
+// more than one word of optimal bits
+constexpr size_t OBJ = 70;
+
+PopSnapshot MakeSnapshot()
+{
+  PopSnapshot snap;
+  snap.gen = 1000; snap.seed = 7; snap.selection = 3; snap.diagnostic = 2; snap.objective_cnt = OBJ;
+
+  for(size_t i = 0; i < POP; ++i)
+  {
+    auto g = std::make_shared<emp::vector<double>>(OBJ);
+    auto s = std::make_shared<emp::vector<double>>(OBJ);
+    auto o = std::make_shared<emp::vector<bool>>(OBJ);
+    for(size_t j = 0; j < OBJ; ++j) {(*g)[j] = i + j / 100.0; (*s)[j] = -(*g)[j]; (*o)[j] = (i + j) % 3 == 0;}
+    snap.Add(g, s, o, i % 2, 100 + i);
+  }
+
+  return snap;
+}
+
+TEST_CASE("Snapshots read back in place", "[snapshot]")
+{
+  REQUIRE(MakeSnapshot().Write("snapshot-test.snap"));
+  REQUIRE(!std::filesystem::exists("snapshot-test.snap.tmp"));
+
+  SnapshotReader reader;
+  REQUIRE(reader.Open("snapshot-test.snap"));
+  REQUIRE(reader.GetGen() == 1000);
+  REQUIRE(reader.GetHeader().seed == 7);
+  REQUIRE(reader.GetHeader().selection == 3);
+  REQUIRE(reader.GetPopSize() == POP);
+  REQUIRE(reader.GetObjectiveCnt() == OBJ);
+  REQUIRE(reader.GetHeader().words == 2);
+  REQUIRE(reader.GetHeader().size == std::filesystem::file_size("snapshot-test.snap"));
+
+  // every section starts on its own cache line
+  for(const void * p : {(const void *) reader.Genomes(), (const void *) reader.Scores(), (const void *) reader.OptimalBits(0), (const void *) reader.Clones(), (const void *) reader.Starts()})
+  {
+    REQUIRE(reinterpret_cast<uintptr_t>(p) % snap::ALIGN == 0);
+  }
+
+  bool same = true;
+  for(size_t i = 0; i < POP; ++i)
+  {
+    same = same && reader.Clone(i) == (i % 2) && reader.Start(i) == 100 + i;
+    for(size_t j = 0; j < OBJ; ++j)
+    {
+      same = same && reader.Genome(i)[j] == i + j / 100.0 && reader.Score(i)[j] == -(i + j / 100.0);
+      same = same && reader.Optimal(i, j) == ((i + j) % 3 == 0);
+    }
+  }
+  REQUIRE(same);
+
+  // whole matrices are row major
+  REQUIRE(reader.Genomes()[3 * OBJ + 5] == reader.Genome(3)[5]);
+
+  reader.Close();
+  std::remove("snapshot-test.snap");
+}
+
+TEST_CASE("Damaged snapshots are refused", "[snapshot]")
+{
+  REQUIRE(MakeSnapshot().Write("snapshot-test.snap"));
+  std::filesystem::resize_file("snapshot-test.snap", std::filesystem::file_size("snapshot-test.snap") - 8);
+
+  SnapshotReader reader;
+  REQUIRE(!reader.Open("snapshot-test.snap"));
+
+  {
+    std::ofstream os("snapshot-test.snap", std::ios::trunc);
+    os << "not a snapshot";
+  }
+  REQUIRE(!reader.Open("snapshot-test.snap"));
+  REQUIRE(!reader.Open("snapshot-test-missing.snap"));
+
+  std::remove("snapshot-test.snap");
+}
@@ -0,0 +1,177 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/stream.h"
+
+// empirical headers
+#include "base/vector.h"
+
+// library includes
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ stream-test.cpp -o stream-test; ./stream-test
+
+// const vars for test
+constexpr size_t SEED = 17;
+constexpr size_t RUNS = 100000;
+
+TEST_CASE("Philox known answers", "[philox]")
+{
+  // known answer tests from the Random123 distribution
+  Stream::ctr_t zero = Stream::Philox({0,0,0,0}, {0,0});
+  REQUIRE(zero == Stream::ctr_t{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+
+  Stream::ctr_t ones = Stream::Philox({0xffffffff,0xffffffff,0xffffffff,0xffffffff}, {0xffffffff,0xffffffff});
+  REQUIRE(ones == Stream::ctr_t{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+
+  Stream::ctr_t pi = Stream::Philox({0x243f6a88,0x85a308d3,0x13198a2e,0x03707344}, {0xa4093822,0x299f31d0});
+  REQUIRE(pi == Stream::ctr_t{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+}
+
+TEST_CASE("Keyed streams", "[key]")
+{
+  Stream a(SEED); Stream b(SEED); Stream c(SEED + 1);
+
+  // same key gives the same sequence, no matter what was drawn before
+  a.Key(10, Stream::SELECTION, 3);
+  for(size_t i = 0; i < 7; ++i) {b.Get();}
+  b.Key(10, Stream::SELECTION, 3);
+
+  emp::vector<uint32_t> first(20);
+  for(auto & x : first) {x = a.Get();}
+  for(auto & x : first) {REQUIRE(x == b.Get());}
+
+  // different generation, phase, id or seed gives a different sequence
+  std::set<uint32_t> starts;
+  a.Key(10, Stream::SELECTION, 3); starts.insert(a.Get());
+  a.Key(11, Stream::SELECTION, 3); starts.insert(a.Get());
+  a.Key(10, Stream::MUTATION, 3); starts.insert(a.Get());
+  a.Key(10, Stream::SELECTION, 4); starts.insert(a.Get());
+  c.Key(10, Stream::SELECTION, 3); starts.insert(c.Get());
+  REQUIRE(starts.size() == 5);
+}
+
+TEST_CASE("Stream draws", "[draws]")
+{
+  Stream s(SEED);
+  s.Key(0, Stream::MUTATION, 0);
+
+  // uniform doubles stay in [0,1) and average out to 0.5
+  double tot = 0.0;
+  for(size_t i = 0; i < RUNS; ++i)
+  {
+    const double d = s.GetDouble();
+    REQUIRE(0.0 <= d); REQUIRE(d < 1.0);
+    tot += d;
+  }
+  REQUIRE(std::abs(tot / RUNS - 0.5) < 0.01);
+
+  // normals have the right mean and standard deviation
+  double sum = 0.0; double sq = 0.0;
+  for(size_t i = 0; i < RUNS; ++i)
+  {
+    const double n = s.GetRandNormal(1.0, 2.0);
+    sum += n; sq += n * n;
+  }
+  const double mean = sum / RUNS;
+  REQUIRE(std::abs(mean - 1.0) < 0.05);
+  REQUIRE(std::abs(std::sqrt(sq / RUNS - mean * mean) - 2.0) < 0.05);
+
+  // bernoulli trials hit at the right rate
+  size_t hits = 0;
+  for(size_t i = 0; i < RUNS; ++i) {hits += s.P(0.007);}
+  REQUIRE(std::abs(static_cast<double>(hits) / RUNS - 0.007) < 0.002);
+}
+
+TEST_CASE("Stream helpers", "[helpers]")
+{
+  Stream s(SEED);
+  s.Key(0, Stream::SELECTION, 0);
+
+  // shuffle keeps every id
+  emp::vector<size_t> ids(50);
+  std::iota(ids.begin(), ids.end(), 0);
+  s.Shuffle(ids);
+  emp::vector<size_t> sorted = ids;
+  std::sort(sorted.begin(), sorted.end());
+  for(size_t i = 0; i < sorted.size(); ++i) {REQUIRE(sorted[i] == i);}
+
+  // choose gives K unique ids in range
+  for(size_t k = 0; k <= 10; ++k)
+  {
+    emp::vector<size_t> pick = s.Choose(10, k);
+    std::set<size_t> uni(pick.begin(), pick.end());
+    REQUIRE(pick.size() == k);
+    REQUIRE(uni.size() == k);
+    for(auto id : pick) {REQUIRE(id < 10);}
+  }
+}
+
+TEST_CASE("Bulk draws", "[bulk]")
+{
+  // bulk philox matches the block function one block at a time
+  const Stream::ctr_t start = {5, 6, 7, 8};
+  const Stream::key_t key = {9, 10};
+  emp::vector<uint32_t> words(Stream::BLOCK * Stream::MAX_BLOCKS);
+  Stream::Philox(start, key, Stream::MAX_BLOCKS, words.data());
+  for(uint32_t b = 0; b < Stream::MAX_BLOCKS; ++b)
+  {
+    const Stream::ctr_t block = Stream::Philox({start[0] + b, start[1], start[2], start[3]}, key);
+    for(size_t w = 0; w < Stream::BLOCK; ++w) {REQUIRE(words[Stream::BLOCK * b + w] == block[w]);}
+  }
+
+  // bulk draws give the same sequence as single draws, across batch sizes
+  Stream a(SEED); Stream b(SEED);
+  a.Key(3, Stream::MUTATION, 2); b.Key(3, Stream::MUTATION, 2);
+
+  emp::vector<uint32_t> raw(7);
+  a.GetWords(raw.data(), raw.size());
+  for(uint32_t w : raw) {REQUIRE(w == b.Get());}
+
+  emp::vector<double> uni(1001);
+  a.GetDoubles(uni.data(), uni.size());
+  for(double u : uni) {REQUIRE(u == b.GetDouble());}
+
+  emp::vector<double> norm(777);
+  a.GetRandNormals(norm.data(), 3, 1.0, 2.0);
+  a.GetRandNormals(norm.data() + 3, norm.size() - 3, 1.0, 2.0);
+  for(double n : norm) {REQUIRE(n == b.GetRandNormal(1.0, 2.0));}
+
+  // bulk shuffles swap exactly like one GetUInt per position (more positions than one batch holds)
+  emp::vector<size_t> bulk(Stream::BLOCK * Stream::MAX_BLOCKS + 50);
+  std::iota(bulk.begin(), bulk.end(), 0);
+  emp::vector<size_t> single = bulk;
+  a.Key(4, Stream::SELECTION, 9); b.Key(4, Stream::SELECTION, 9);
+  a.Shuffle(bulk);
+  for(size_t i = 0; i + 1 < single.size(); ++i) {std::swap(single[i], single[b.GetUInt(i, single.size())]);}
+  REQUIRE(bulk == single);
+  REQUIRE(a.Get() == b.Get());
+
+  // normals come from their own sub-stream, so they never shift the uniforms
+  Stream c(SEED); Stream d(SEED);
+  c.Key(3, Stream::SELECTION, 2); d.Key(3, Stream::SELECTION, 2);
+  for(size_t i = 0; i < 500; ++i)
+  {
+    c.GetRandNormal(0.0, 1.0);
+    REQUIRE(c.Get() == d.Get());
+  }
+}
+
+TEST_CASE("Drawn seeds", "[seed]")
+{
+  // runs started back to back still get their own seed, always in range
+  std::set<int> seeds;
+  for(size_t i = 0; i < 100; ++i)
+  {
+    const int seed = Stream::DrawSeed();
+    REQUIRE(0 < seed);
+    REQUIRE(seed <= INT_MAX / 2);
+    seeds.insert(seed);
+  }
+  REQUIRE(seeds.size() == 100);
+}
@@ -0,0 +1,77 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/termination.h"
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ termination-test.cpp -o termination-test; ./termination-test
+
+TEST_CASE("Nothing configured", "[check]")
+{
+  DiaConfig config;
+  REQUIRE(!Termination::Enabled(config));
+
+  Termination term(config);
+  Status status;
+  for(size_t g = 0; g < 100; ++g) {status.gen = g; REQUIRE(!term.Check(status));}
+  REQUIRE(term.GetReason() == "");
+}
+
+TEST_CASE("Full optimization", "[check]")
+{
+  DiaConfig config;
+  config.OBJECTIVE_CNT(10);
+  config.STOP_OPTIMIZED(true);
+  REQUIRE(Termination::Enabled(config));
+
+  Termination term(config);
+  Status status;
+  status.opt_cnt = 9;
+  REQUIRE(!term.Check(status));
+  status.opt_cnt = 10;
+  REQUIRE(term.Check(status));
+  REQUIRE(term.GetReason() == "optimized");
+}
+
+TEST_CASE("Stagnation", "[check]")
+{
+  DiaConfig config;
+  config.STAG_GENS(5);
+
+  Termination term(config);
+  Status status;
+
+  // improvements restart the count, equal values do not
+  status.gen = 0; status.ele_agg = 1.0; REQUIRE(!term.Check(status));
+  status.gen = 3; status.ele_agg = 2.0; REQUIRE(!term.Check(status));
+  status.gen = 7; status.ele_agg = 2.0; REQUIRE(!term.Check(status));
+  status.gen = 8; status.ele_agg = 1.5; REQUIRE(term.Check(status));
+  REQUIRE(term.GetReason() == "stagnation_ele_agg_per");
+  REQUIRE(term.GetStagBest() == 2.0);
+  REQUIRE(term.GetStagSince() == 3);
+
+  // a resumed run carries the state on
+  Termination again(config);
+  again.SetStagnation(2.0, 3);
+  status.gen = 7; REQUIRE(!again.Check(status));
+  status.gen = 8; REQUIRE(again.Check(status));
+}
+
+TEST_CASE("Budgets and custom criteria", "[check]")
+{
+  DiaConfig config;
+  config.MAX_EVALS(1000);
+
+  Termination term(config);
+  term.Add("custom", [](const Status & s) {return s.gen == 42;});
+
+  Status status;
+  status.obj_evals = 999; REQUIRE(!term.Check(status));
+  status.gen = 42; REQUIRE(term.Check(status));
+  REQUIRE(term.GetReason() == "custom");
+
+  // configured criteria come before custom ones
+  status.obj_evals = 1000; REQUIRE(term.Check(status));
+  REQUIRE(term.GetReason() == "max_evals");
+}
@@ -0,0 +1,109 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/timing.h"
+
+// library includes
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -I ../../../Empirical/source/ timing-test.cpp -o timing-test; ./timing-test
+
+std::string ReadAll(const std::string & path)
+{
+  std::ifstream is(path);
+  return std::string((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+}
+
+TEST_CASE("Histogram buckets", "[histogram]")
+{
+  // every value lands in the bucket covering it, and buckets follow each other
+  for(uint64_t v = 0; v < 5000; ++v)
+  {
+    const size_t b = Histogram::Bucket(v);
+    REQUIRE(Histogram::Lower(b) <= v);
+    REQUIRE(v < Histogram::Lower(b + 1));
+  }
+  REQUIRE(Histogram::Bucket(~uint64_t(0)) == Histogram::BUCKETS - 1);
+
+  Histogram h;
+  for(uint64_t v = 1; v <= 1000; ++v) {h.Add(v * 1000);}
+  REQUIRE(h.GetCount() == 1000);
+  REQUIRE(h.GetMin() == 1000);
+  REQUIRE(h.GetMax() == 1000000);
+  REQUIRE(h.GetMean() == Approx(500500.0));
+
+  // quantiles are within a bucket (12.5%) of the truth
+  REQUIRE(h.Quantile(0.5) == Approx(500000.0).epsilon(0.125));
+  REQUIRE(h.Quantile(0.99) == Approx(990000.0).epsilon(0.125));
+  REQUIRE(h.Quantile(1.0) <= 1000000.0);
+
+  Histogram other;
+  other.Add(7);
+  other.Merge(h);
+  REQUIRE(other.GetCount() == 1001);
+  REQUIRE(other.GetMin() == 7);
+}
+
+TEST_CASE("Timers", "[timer]")
+{
+  Histogram h;
+  {
+    Timer off;
+    Timer on(&h);
+    Timer moved = std::move(on);
+  }
+  REQUIRE(h.GetCount() == 1);
+
+  Timer t(&h);
+  t.Stop();
+  t.Stop();
+  REQUIRE(h.GetCount() == 2);
+}
+
+TEST_CASE("Timing rows and resuming", "[timing]")
+{
+  {
+    Timing timing("timing-test.csv", 10);
+    for(size_t gen = 0; gen < 25; ++gen)
+    {
+      Timer t = timing.Time(Timing::GENERATION);
+      timing.Time(Timing::EVALUATE);
+      t.Stop();
+      timing.Step(gen);
+    }
+    timing.Finish();
+
+    REQUIRE(timing.GetTotal(Timing::GENERATION).GetCount() == 25);
+    REQUIRE(timing.GetTotal(Timing::SELECT).GetCount() == 0);
+
+    std::ostringstream os;
+    timing.Summarize(os);
+    REQUIRE(os.str().find("Timing over 25 generations") == 0);
+    REQUIRE(os.str().find("  evaluate: ") != std::string::npos);
+    REQUIRE(os.str().find("select") == std::string::npos);
+  }
+
+  // header plus generation and evaluate rows at 0, 10, 20 and the unfinished 24
+  std::istringstream is(ReadAll("timing-test.csv"));
+  std::string line;
+  size_t rows = 0;
+  std::getline(is, line);
+  REQUIRE(line == "gen,phase,count,total_ms,mean_us,p50_us,p90_us,p99_us,max_us");
+  while(std::getline(is, line)) {++rows;}
+  REQUIRE(rows == 8);
+
+  // resuming from generation 15 keeps the rows before it
+  {
+    Timing timing("timing-test.csv", 10, 15);
+  }
+  const std::string kept = ReadAll("timing-test.csv");
+  REQUIRE(kept.find("\n10,generation,10,") != std::string::npos);
+  REQUIRE(kept.find("\n20,") == std::string::npos);
+
+  std::remove("timing-test.csv");
+}
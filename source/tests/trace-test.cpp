@@ -0,0 +1,84 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/trace.h"
+
+// library includes
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -pthread -I ../../../Empirical/source/ trace-test.cpp -o trace-test; ./trace-test
+
+std::string ReadAll(const std::string & path)
+{
+  std::ifstream is(path);
+  return std::string((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+}
+
+size_t Count(const std::string & text, const std::string & what)
+{
+  size_t cnt = 0;
+  for(size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1)) {++cnt;}
+  return cnt;
+}
+
+TEST_CASE("Window", "[trace]")
+{
+  Trace trace("trace-test.json", 5, 3);
+  REQUIRE(!trace.Covers(4));
+  REQUIRE(trace.Covers(5));
+  REQUIRE(trace.Covers(7));
+  REQUIRE(!trace.Covers(8));
+
+  for(size_t gen = 0; gen < 10; ++gen) {Trace::Span span = trace.Scope("generation", "phase", gen);}
+  REQUIRE(trace.GetEventCnt() == 3);
+
+  // a loop of chunks: every assignment ends the span before it
+  {
+    Trace::Span chunk;
+    for(size_t i = 0; i < 200; ++i)
+    {
+      if(i % Trace::CHUNK == 0) {chunk = trace.Scope("evaluate chunk", "kernel", 6);}
+    }
+  }
+  REQUIRE(trace.GetEventCnt() == 3 + 4);
+}
+
+TEST_CASE("Threads write their own lanes", "[trace]")
+{
+  {
+    Trace trace("trace-test.json", 0, 10);
+    trace.NameProcess(0, "world");
+    trace.NameThread(0, "main");
+
+    std::vector<std::thread> threads;
+    for(size_t w = 1; w <= 3; ++w)
+    {
+      threads.emplace_back([&trace, w]()
+      {
+        trace.NameThread(0, "worker " + std::to_string(w));
+        for(size_t gen = 0; gen < 20; ++gen) {Trace::Span span = trace.Scope("reproduce chunk", "kernel", gen);}
+      });
+    }
+    for(auto & t : threads) {t.join();}
+
+    Trace::Span span = trace.Scope("generation", "phase", 0);
+    span.End();
+    REQUIRE(trace.GetEventCnt() == 3 * 10 + 1);
+  }
+
+  const std::string json = ReadAll("trace-test.json");
+  REQUIRE(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+  REQUIRE(json.find("\n]}\n") != std::string::npos);
+  REQUIRE(Count(json, "\"ph\":\"X\"") == 31);
+  REQUIRE(Count(json, "\"name\":\"thread_name\"") == 4);
+  REQUIRE(json.find("\"args\":{\"name\":\"worker 3\"}") != std::string::npos);
+  REQUIRE(json.find("\"args\":{\"name\":\"world\"}") != std::string::npos);
+
+  std::remove("trace-test.json");
+}
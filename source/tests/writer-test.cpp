@@ -0,0 +1,83 @@
+#define CATCH_CONFIG_MAIN
+
+// testing files
+#include "/mnt/c/Users/josex/Desktop/Research/Repos/Catch/catch.hpp"
+#include "../source/writer.h"
+
+// library includes
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// In Tests directory, to run:
+// clang++ -std=c++17 -pthread -I ../../../Empirical/source/ writer-test.cpp -o writer-test; ./writer-test
+
+std::string ReadAll(const std::string & path)
+{
+  std::ifstream is(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+}
+
+TEST_CASE("Ring wraps around", "[ring]")
+{
+  Ring ring(64);
+  REQUIRE(ring.GetCapacity() == 64);
+
+  const std::string text(100, 'x');
+  REQUIRE(ring.Push(text.data(), 100) == 64);
+  REQUIRE(ring.Push(text.data(), 1) == 0);
+
+  // consume 40, then push across the end
+  ring.Pop(40);
+  const std::string more = "0123456789012345678901234567890123456789";
+  REQUIRE(ring.Push(more.data(), more.size()) == 40);
+
+  const char * a; const char * b; size_t na, nb;
+  REQUIRE(ring.Peek(a, na, b, nb) == 64);
+  REQUIRE(na == 24);
+  REQUIRE(nb == 40);
+  REQUIRE(std::string(b, nb) == more);
+}
+
+TEST_CASE("AsyncFile writes every row in order", "[file]")
+{
+  std::ostringstream expect;
+  {
+    // a tiny ring makes the producer wait on the writer over and over
+    AsyncFile file("writer-test.csv", 64);
+    std::ostream & os = file.GetStream();
+    for(size_t i = 0; i < 5000; ++i)
+    {
+      os << i << "," << 0.5 * i << "\n";
+      expect << i << "," << 0.5 * i << "\n";
+      if(i % 100 == 0) {os.flush();}
+    }
+    REQUIRE(file.Good());
+    REQUIRE(0 < file.GetStalls());
+  }
+
+  REQUIRE(ReadAll("writer-test.csv") == expect.str());
+  std::remove("writer-test.csv");
+}
+
+TEST_CASE("AsyncFile flush and append", "[file]")
+{
+  {
+    AsyncFile file("writer-test.csv", 1 << 16);
+    file.GetStream() << "gen,fit\n0,1\n";
+
+    // a checkpoint measures the file after a flush
+    file.Flush();
+    REQUIRE(std::filesystem::file_size("writer-test.csv") == 12);
+  }
+
+  {
+    AsyncFile file("writer-test.csv", 1 << 16, true);
+    file.GetStream() << "1,2\n" << std::flush;
+  }
+
+  REQUIRE(ReadAll("writer-test.csv") == "gen,fit\n0,1\n1,2\n");
+  std::remove("writer-test.csv");
+}
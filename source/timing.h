@@ -0,0 +1,280 @@
+/// Wall clock instrumentation: scoped timers around the phases of a generation feed log-bucket histograms,
+/// which are written to timing.csv every few generations and summarized once the run is over
+/// A Timing object is only touched by the main thread (the pipe thread hands its time over through the world)
+
+#ifndef TIMING_H
+#define TIMING_H
+
+///< standard headers
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+///< empirical headers
+#include "base/vector.h"
+
+/// Durations in nanoseconds, counted in buckets four to a power of two (so a quantile is off by at most 12.5%)
+class Histogram
+{
+  public:
+    // every uint64_t value has a bucket
+    static constexpr size_t BUCKETS = 252;
+
+    ///< helper functions
+
+    void Add(const uint64_t ns);
+    void Merge(const Histogram & other);
+    void Clear() {*this = Histogram();}
+
+    size_t GetCount() const {return count;}
+    uint64_t GetTotal() const {return total;}
+    uint64_t GetMin() const {return count ? min : 0;}
+    uint64_t GetMax() const {return max;}
+    double GetMean() const {return count ? static_cast<double>(total) / count : 0.0;}
+
+    // middle of the bucket holding the q-th quantile (kept within the smallest and largest values seen)
+    double Quantile(const double q) const;
+
+    // bucket a value falls in, and the smallest value in a bucket
+    static size_t Bucket(const uint64_t ns);
+    static uint64_t Lower(const size_t b);
+
+  private:
+    std::array<uint64_t, BUCKETS> buckets{};
+    size_t count = 0;
+    uint64_t total = 0;
+    uint64_t min = std::numeric_limits<uint64_t>::max();
+    uint64_t max = 0;
+};
+
+size_t Histogram::Bucket(const uint64_t ns)
+{
+  if(ns < 4) {return ns;}
+
+  // top bit picks the power of two, the two bits under it pick the quarter
+  const size_t e = 63 - __builtin_clzll(ns);
+  return 4 * (e - 1) + ((ns >> (e - 2)) & 3);
+}
+
+uint64_t Histogram::Lower(const size_t b)
+{
+  if(b < 4) {return b;}
+
+  const size_t e = b / 4 + 1;
+  return static_cast<uint64_t>(4 + b % 4) << (e - 2);
+}
+
+void Histogram::Add(const uint64_t ns)
+{
+  ++buckets[Bucket(ns)];
+  ++count;
+  total += ns;
+  min = std::min(min, ns);
+  max = std::max(max, ns);
+}
+
+void Histogram::Merge(const Histogram & other)
+{
+  for(size_t b = 0; b < BUCKETS; ++b) {buckets[b] += other.buckets[b];}
+  count += other.count;
+  total += other.total;
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+}
+
+double Histogram::Quantile(const double q) const
+{
+  if(count == 0) {return 0.0;}
+
+  const double want = q * count;
+  uint64_t seen = 0;
+  size_t b = 0;
+  for(; b < BUCKETS; ++b)
+  {
+    seen += buckets[b];
+    if(want <= seen && 0 < seen) {break;}
+  }
+  b = std::min(b, BUCKETS - 1);
+
+  const double low = Lower(b);
+  const double high = (b + 1 < BUCKETS) ? Lower(b + 1) : low * 1.25;
+  return std::clamp(0.5 * (low + high), static_cast<double>(GetMin()), static_cast<double>(max));
+}
+
+/// Adds the time between its construction and Stop (or its end) to a histogram (does nothing without one)
+class Timer
+{
+  public:
+    using clock_t = std::chrono::steady_clock;
+
+    Timer(Histogram * _hist = nullptr) : hist(_hist) {if(hist) {start = clock_t::now();}}
+    Timer(Timer && other) : hist(other.hist), start(other.start) {other.hist = nullptr;}
+    Timer(const Timer &) = delete;
+    ~Timer() {Stop();}
+
+    // record now instead of at the end of the scope
+    void Stop() {if(hist) {hist->Add(Since(start)); hist = nullptr;}}
+
+    // nanoseconds since t
+    static uint64_t Since(const clock_t::time_point t)
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - t).count();
+    }
+
+  private:
+    Histogram * hist;
+    clock_t::time_point start;
+};
+
+class Timing
+{
+  // object types we are using in this class
+  public:
+    // timed phases (nested ones are counted inside their parents too)
+    enum Phase : size_t
+    {
+      GENERATION = 0,  // the whole generation
+      RESET,           // ResetData
+      EVALUATE,        // EvaluationStep
+      MIGRATE,         // swapping solutions with other islands
+      SELECT,          // SelectionStep
+      SELECTOR,        // the selection scheme inside SelectionStep
+      RECORD,          // RecordData (includes ANALYZE unless it runs on the pipe thread)
+      ANALYZE,         // computing and writing the census metrics
+      REPRODUCE,       // ReproductionStep
+      LINEAGE,         // LineageStep
+      CHECKPOINT,      // CheckpointStep and SnapshotStep
+      PHASES
+    };
+
+
+  public:
+
+    /**
+     * Constructor:
+     *
+     * @param path timing.csv to write.
+     * @param _interval Generations between rows.
+     * @param from Generation a resumed run carries on from (rows it already has before that are kept).
+     */
+    Timing(const std::string & path, const size_t _interval, const size_t from = 0);
+
+    ///< helper functions
+
+    // timer feeding a phase
+    Timer Time(const size_t phase) {return Timer(&current[phase]);}
+
+    // add a duration measured elsewhere (on the pipe thread)
+    void Add(const size_t phase, const uint64_t ns) {current[phase].Add(ns);}
+
+    // end of generation gen: writes this interval's rows when it is due
+    void Step(const size_t gen);
+
+    // writes the rows of an interval cut short by the end of the run
+    void Finish();
+
+    // whole run histogram of a phase (what has been written so far)
+    const Histogram & GetTotal(const size_t phase) const {return totals[phase];}
+    const Histogram & GetCurrent(const size_t phase) const {return current[phase];}
+
+    // one line per phase with its share of the generation time
+    void Summarize(std::ostream & os) const;
+
+    static const char * Name(const size_t phase);
+
+  private:
+    // write this interval's rows and fold them into the totals
+    void Write();
+
+  private:
+    std::ofstream file;
+    size_t interval;
+    // last generation stepped
+    size_t gen = 0;
+
+    std::array<Histogram, PHASES> current;
+    std::array<Histogram, PHASES> totals;
+};
+
+Timing::Timing(const std::string & path, const size_t _interval, const size_t from) : interval(_interval)
+{
+  // a resumed run keeps the rows written before its checkpoint (later ones are timed again)
+  std::string kept;
+  if(0 < from)
+  {
+    std::ifstream is(path);
+    std::string line;
+    std::getline(is, line);
+    while(std::getline(is, line))
+    {
+      if(std::stoull("0" + line.substr(0, line.find(','))) < from) {kept += line + "\n";}
+    }
+  }
+
+  file.open(path, std::ios::trunc);
+  if(!file) {std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;}
+  file << "gen,phase,count,total_ms,mean_us,p50_us,p90_us,p99_us,max_us\n" << kept << std::flush;
+}
+
+void Timing::Step(const size_t _gen)
+{
+  gen = _gen;
+  if(interval && gen % interval == 0) {Write();}
+}
+
+void Timing::Finish()
+{
+  if(current[GENERATION].GetCount() || current[ANALYZE].GetCount()) {Write();}
+}
+
+void Timing::Write()
+{
+  file << std::fixed << std::setprecision(3);
+  for(size_t p = 0; p < PHASES; ++p)
+  {
+    const Histogram & h = current[p];
+    if(h.GetCount() == 0) {continue;}
+
+    file << gen << "," << Name(p) << "," << h.GetCount() << "," << h.GetTotal() / 1e6 << "," << h.GetMean() / 1e3
+         << "," << h.Quantile(0.5) / 1e3 << "," << h.Quantile(0.9) / 1e3 << "," << h.Quantile(0.99) / 1e3 << "," << h.GetMax() / 1e3 << "\n";
+
+    totals[p].Merge(h);
+    current[p].Clear();
+  }
+  file.flush();
+}
+
+void Timing::Summarize(std::ostream & os) const
+{
+  const double whole = std::max<double>(1.0, totals[GENERATION].GetTotal());
+  const auto flags = os.flags();
+  const auto precision = os.precision();
+
+  os << "Timing over " << totals[GENERATION].GetCount() << " generations (mean, p50, p99 per call):" << std::endl;
+  for(size_t p = 0; p < PHASES; ++p)
+  {
+    const Histogram & h = totals[p];
+    if(h.GetCount() == 0) {continue;}
+
+    os << std::fixed << std::setprecision(3)
+       << "  " << Name(p) << ": " << h.GetTotal() / 1e9 << " s (" << std::setprecision(1) << 100.0 * h.GetTotal() / whole << "%), "
+       << std::setprecision(3) << h.GetMean() / 1e3 << " us, " << h.Quantile(0.5) / 1e3 << " us, " << h.Quantile(0.99) / 1e3 << " us" << std::endl;
+  }
+
+  os.flags(flags);
+  os.precision(precision);
+}
+
+const char * Timing::Name(const size_t phase)
+{
+  static const char * names[PHASES] = {"generation", "reset", "evaluate", "migrate", "select", "selector", "record", "analyze", "reproduce", "lineage", "checkpoint"};
+  return phase < PHASES ? names[phase] : "unknown";
+}
+
+#endif
@@ -0,0 +1,249 @@
+/// Timeline tracing: begin/end spans of generation phases, kernels and I/O from every thread over a window of generations,
+/// written as Chrome trace-event JSON (trace.json, opens in Perfetto or chrome://tracing)
+/// Every thread records into its own lane without locking, lanes are only read once the traced threads are done
+
+#ifndef TRACE_H
+#define TRACE_H
+
+///< standard headers
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+///< empirical headers
+#include "base/Ptr.h"
+#include "base/vector.h"
+
+class Trace
+{
+  // object types we are using in this class
+  public:
+    // clock behind the timestamps
+    using clock_t = std::chrono::steady_clock;
+
+    // loop iterations covered by one kernel span (evaluations, selection calls)
+    static constexpr size_t CHUNK = 64;
+
+    // one finished span (names are string literals)
+    struct Event
+    {
+      const char * name;
+      const char * cat;
+      uint64_t start;
+      uint64_t dur;
+      uint64_t gen;
+    };
+
+    /// Records a span from its construction to End (or its end), does nothing when default constructed
+    class Span
+    {
+      public:
+        Span() {;}
+        Span(Trace * _trace, const char * _name, const char * _cat, const uint64_t _gen)
+          : trace(_trace), name(_name), cat(_cat), gen(_gen), start(_trace->Now()) {;}
+        Span(Span && other) : trace(other.trace), name(other.name), cat(other.cat), gen(other.gen), start(other.start) {other.trace = nullptr;}
+        Span(const Span &) = delete;
+        ~Span() {End();}
+
+        // ends this span and takes over other (starting the next span of a loop)
+        Span & operator=(Span && other)
+        {
+          End();
+          trace = other.trace; name = other.name; cat = other.cat; gen = other.gen; start = other.start;
+          other.trace = nullptr;
+          return *this;
+        }
+
+        // close the span now instead of at the end of the scope
+        void End() {if(trace) {trace->Record({name, cat, start, trace->Now() - start, gen}); trace = nullptr;}}
+
+      private:
+        Trace * trace = nullptr;
+        const char * name = nullptr;
+        const char * cat = nullptr;
+        uint64_t gen = 0;
+        uint64_t start = 0;
+    };
+
+
+  public:
+
+    /**
+     * Constructor:
+     *
+     * @param _path trace.json to write.
+     * @param _from First generation traced.
+     * @param _gens Number of generations traced.
+     */
+    Trace(const std::string & _path, const size_t _from, const size_t _gens);
+
+    // writes the file (every traced thread has to be done by now)
+    ~Trace();
+
+    ///< helper functions
+
+    // is generation gen inside the window?
+    bool Covers(const size_t gen) const {return from <= gen && gen - from < gens;}
+
+    // span for generation gen (inert outside the window)
+    Span Scope(const char * name, const char * cat, const size_t gen) {return Covers(gen) ? Span(this, name, cat, gen) : Span();}
+
+    // label the calling thread (pid groups threads, e.g. by island)
+    void NameThread(const size_t pid, const std::string & name);
+
+    // label a pid
+    void NameProcess(const size_t pid, const std::string & name);
+
+    // spans recorded so far (only safe once the traced threads are done)
+    size_t GetEventCnt() const;
+
+    // nanoseconds since the trace started
+    uint64_t Now() const {return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - begin).count();}
+
+  private:
+    // events of one thread
+    struct Lane
+    {
+      std::thread::id id;
+      size_t pid = 0;
+      std::string name;
+      emp::vector<Event> events;
+    };
+
+    // calling thread's lane (made on its first span)
+    Lane & Mine();
+
+    // add a finished span to the calling thread's lane
+    void Record(const Event & event) {Mine().events.push_back(event);}
+
+    // write the trace file
+    void Write() const;
+
+  private:
+    std::string path;
+    size_t from;
+    size_t gens;
+    clock_t::time_point begin;
+
+    // tells lanes cached by threads apart from those of an earlier trace
+    uint64_t serial;
+
+    // guards the lane list and process names (not the events in a lane)
+    mutable std::mutex lock;
+    emp::vector<emp::Ptr<Lane>> lanes;
+    std::map<size_t, std::string> processes;
+};
+
+Trace::Trace(const std::string & _path, const size_t _from, const size_t _gens)
+  : path(_path), from(_from), gens(_gens), begin(clock_t::now())
+{
+  static std::atomic<uint64_t> traces{0};
+  serial = ++traces;
+}
+
+Trace::~Trace()
+{
+  Write();
+  for(auto & lane : lanes) {lane.Delete();}
+}
+
+void Trace::NameThread(const size_t pid, const std::string & name)
+{
+  Lane & lane = Mine();
+  if(lane.name == name && lane.pid == pid) {return;}
+
+  std::lock_guard<std::mutex> guard(lock);
+  lane.pid = pid;
+  lane.name = name;
+}
+
+void Trace::NameProcess(const size_t pid, const std::string & name)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  processes[pid] = name;
+}
+
+size_t Trace::GetEventCnt() const
+{
+  std::lock_guard<std::mutex> guard(lock);
+  size_t cnt = 0;
+  for(const auto & lane : lanes) {cnt += lane->events.size();}
+  return cnt;
+}
+
+Trace::Lane & Trace::Mine()
+{
+  // one cached lane per thread, looked up again when the thread moves on to another trace
+  thread_local uint64_t cached_serial = 0;
+  thread_local Lane * cached = nullptr;
+  if(cached_serial == serial) {return *cached;}
+
+  std::lock_guard<std::mutex> guard(lock);
+  const std::thread::id id = std::this_thread::get_id();
+
+  Lane * found = nullptr;
+  for(auto & lane : lanes) {if(lane->id == id) {found = lane.Raw();}}
+  if(found == nullptr)
+  {
+    lanes.push_back(emp::NewPtr<Lane>());
+    found = lanes.back().Raw();
+    found->id = id;
+    found->name = "thread " + std::to_string(lanes.size() - 1);
+  }
+
+  cached_serial = serial;
+  cached = found;
+  return *found;
+}
+
+void Trace::Write() const
+{
+  std::ofstream os(path);
+  if(!os)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << std::endl;
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  char buf[64];
+  bool first = true;
+  auto sep = [&os, &first]() {os << (first ? "\n" : ",\n"); first = false;};
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  // labels first
+  for(const auto & proc : processes)
+  {
+    sep();
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << proc.first << ",\"args\":{\"name\":\"" << proc.second << "\"}}";
+  }
+  for(size_t t = 0; t < lanes.size(); ++t)
+  {
+    sep();
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << lanes[t]->pid << ",\"tid\":" << t << ",\"args\":{\"name\":\"" << lanes[t]->name << "\"}}";
+  }
+
+  // complete events, timestamps in microseconds
+  for(size_t t = 0; t < lanes.size(); ++t)
+  {
+    for(const Event & e : lanes[t]->events)
+    {
+      sep();
+      std::snprintf(buf, sizeof(buf), "%.3f,\"dur\":%.3f", e.start / 1e3, e.dur / 1e3);
+      os << "{\"name\":\"" << e.name << "\",\"cat\":\"" << e.cat << "\",\"ph\":\"X\",\"ts\":" << buf
+         << ",\"pid\":" << lanes[t]->pid << ",\"tid\":" << t << ",\"args\":{\"gen\":" << e.gen << "}}";
+    }
+  }
+
+  os << "\n]}\n";
+}
+
+#endif
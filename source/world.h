@@ -4,9 +4,13 @@
 #define DIA_WORLD_H
 
 ///< standard headers
+#include <filesystem>
+#include <fstream>
 #include <functional>
 #include <map>
-#include <set>
+#include <numeric>
+#include <sstream>
+#include <typeinfo>
 
 ///< empirical headers
 #include "Evolve/World.h"
@@ -14,43 +18,38 @@
 #include "tools/random_utils.h"
 
 ///< experiment headers
+#include "alloc.h"
+#include "checkpoint.h"
+#include "columns.h"
 #include "config.h"
+#include "counters.h"
+#include "lineage.h"
+#include "logger.h"
+#include "metrics.h"
+#include "mutation.h"
 #include "org.h"
+#include "pipe.h"
+#include "pool.h"
 #include "problem.h"
+#include "sampler.h"
 #include "selection.h"
+#include "snapshot.h"
+#include "stream.h"
+#include "termination.h"
+#include "timing.h"
+#include "trace.h"
+#include "writer.h"
 
 
-template <typename PHEN_TYPE>
-struct pheno_info
+// make sure an OUTPUT_DIR exists before a world writes into it (drivers that make their own directories)
+void MakeOutputDir(const std::string & dir)
 {
-  /// Track information related to the mutational landscape
-  /// Maps a string representing a type of mutation to a count representing
-  /// the number of that type of mutation that occured to bring about this taxon.
-  using phen_t = PHEN_TYPE;
-  using has_phen_t = std::true_type;
-  using has_mutations_t = std::false_type;
-  using has_fitness_t = std::true_type;
-  // using has_phenotype_t = true;
-
-  emp::DataNode<double, emp::data::Current, emp::data::Range> fitness; /// This taxon's fitness (for assessing deleterious mutational steps)
-  PHEN_TYPE phenotype; /// This taxon's phenotype (for assessing phenotypic change)
-
-  const PHEN_TYPE & GetPhenotype() const {
-    return phenotype;
-  }
-
-  const double GetFitness() const {
-    return fitness.GetMean();
-  }
+  if(dir.empty()) {return;}
 
-  void RecordFitness(double fit) {
-    fitness.Add(fit);
-  }
-
-  void RecordPhenotype(PHEN_TYPE phen) {
-    phenotype = phen;
-  }
-};
+  std::error_code err;
+  std::filesystem::create_directories(dir, err);
+  if(err) {std::cerr << "ERROR: COULD NOT CREATE OUTPUT_DIR " << dir << ": " << err.message() << std::endl;}
+}
 
 class DiagWorld : public emp::World<Org>
 {
@@ -88,38 +87,92 @@ class DiagWorld : public emp::World<Org>
     using eval_t = std::function<double(Org &)>;
     // selection function type
     using sele_t = std::function<ids_t()>;
-
-    ///< data tracking stuff (ask about)
-    using nodef_t = emp::Ptr<emp::DataMonitor<double>>;
-    using nodeo_t = emp::Ptr<emp::DataMonitor<size_t>>;
-    using como_t = std::map<size_t, ids_t>;
-
-    ///< systematics tracking types
-    using systematics_t = emp::Systematics<Org, Org::genome_t, pheno_info<typename Org::score_t>>;
-    using taxon_t = typename systematics_t::taxon_t;
+    // migration hook type
+    using migr_t = std::function<void()>;
+    // allocation tag, hardware counters, timer and trace span around a phase of the generation
+    // (the counters start first, so their reads stay out of the timer)
+    struct Probe
+    {
+      Alloc::PhaseTag tag;
+      Counters::Sample count;
+      Timer timer;
+      Trace::Span span;
+      void Stop() {span.End(); timer.Stop(); count.Stop(); tag.Stop();}
+    };
 
     using config_t = DiaConfig;
 
 
   public:
 
-    DiagWorld(DiaConfig & _config) : config(_config), data_file(_config.OUTPUT_DIR() + "data.csv")
+    DiagWorld(DiaConfig & _config, emp::Ptr<Checkpoint> _resume = nullptr) : config(_config), resume(_resume), data_file(data_stream)
     {
+      // SEED 0 (or less) draws one seed (a resumed run takes its checkpoint's), kept in the config so run_config.csv records it
+      if(config.SEED() <= 0) {config.SEED(resume ? static_cast<int>(resume->seed) : Stream::DrawSeed());}
+
       // set random pointer seed
       random_ptr = emp::NewPtr<emp::Random>(config.SEED());
+      // a resumed run picks the generator up where the checkpoint left it (seed included)
+      if(resume) {resume->LoadRandom(*random_ptr);}
+
+      // counter-based streams use the same seed as the random pointer
+      if(config.RNG_STREAMS()) {stream = emp::NewPtr<Stream>(static_cast<uint64_t>(config.SEED()));}
+
+      // console output is held and written out in chunks
+      note.Configure(config.LOG_LEVEL(), config.LOG_BUFFER() * 1024, config.LOG_JSON());
+      log.Configure(config.LOG_LEVEL(), config.LOG_BUFFER() * 1024, config.LOG_JSON());
 
       // initialize the world
       Initialize();
+
+      // only needed while setting up
+      resume = nullptr;
     }
 
     ~DiagWorld()
     {
+      // let the last generation finish recording first
+      if(pipe) {pipe.Delete();}
+      // time of that last recording, then the rest of the timing rows and the summary
+      if(timing)
+      {
+        if(analyze_ns) {timing->Add(Timing::ANALYZE, analyze_ns);}
+        timing->Finish();
+        timing->Summarize(note.Info());
+        timing.Delete();
+      }
+      // let the last checkpoint reach the disk
+      if(saver) {saver.Delete();}
+      // writes the last block and the footer index (not for an interrupted run, which is not finished)
+      if(columns) {columns->Close(stop_reason != "signal"); columns.Delete();}
+      // writes whatever data.csv rows are still buffered
+      data_stream.rdbuf(nullptr);
+      if(data_async) {data_async.Delete();}
+      if(termination) {termination.Delete();}
+      if(lineage) {lineage.Delete();}
+      if(sampler) {sampler.Delete();}
+      for(auto & m : worker_muts) {m.Delete();}
+      for(auto & s : worker_streams) {s.Delete();}
+      if(pool) {pool.Delete();}
+      // counts of every phase, for this selection scheme and diagnostic
+      if(counters)
+      {
+        if(counters->Good()) {counters->Write(config.OUTPUT_DIR() + "counters.csv", config.SELECTION(), config.DIAGNOSTIC());}
+        counters.Delete();
+      }
+      // every thread we traced is done, so the trace can be written
+      if(trace && !trace_shared) {trace.Delete();}
+      // allocations of every phase and call site (alloccheck build only)
+      if constexpr (Alloc::ENABLED)
+      {
+        Alloc::Write(config.OUTPUT_DIR() + "alloc.csv");
+        const Alloc::Count total = Alloc::GetTotal();
+        note.Info() << "Allocations: " << total.allocs << ", " << total.bytes << " bytes, peak " << Alloc::GetPeak() << " bytes live" << std::endl;
+      }
+      mutation.Delete();
       selection.Delete();
+      if(stream) {stream.Delete();}
       diagnostic.Delete();
-      pop_fit.Delete();
-      pop_opti.Delete();
-      pnt_fit.Delete();
-      pnt_opti.Delete();
     }
 
     ///< functions called to setup the world
@@ -133,6 +186,9 @@ class DiagWorld : public emp::World<Org>
     // set mutation operator from World.h
     void SetMutation();
 
+    // set worker threads for reproduction
+    void SetThreads();
+
     // set selction scheme
     void SetSelection();
 
@@ -145,6 +201,36 @@ class DiagWorld : public emp::World<Org>
     // set data tracking with data nodes
     void SetDataTracking();
 
+    // set background data recording
+    void SetPipeline();
+
+    // set periodic checkpoints
+    void SetCheckpoints();
+
+    // set early termination criteria
+    void SetTermination();
+
+    // set phase timers
+    void SetTiming();
+
+    // set timeline tracing
+    void SetTracing();
+
+    // set hardware performance counters
+    void SetCounters();
+
+    // set lineage tracking
+    void SetLineage();
+
+    // record into a trace shared with other worlds instead, under pid (used by island.h)
+    void SetTrace(emp::Ptr<Trace> _trace, const size_t pid);
+
+    // set hook called between evaluation and selection (used by island.h)
+    void SetMigrate(migr_t fun) {migrate = fun;}
+
+    // set where progress lines go (std::cout by default)
+    void SetLog(std::ostream & os) {log.SetTarget(os);}
+
     // populate the world with initial solutions
     void PopulateWorld();
 
@@ -163,9 +249,30 @@ class DiagWorld : public emp::World<Org>
     // reprodutive step
     void ReproductionStep();
 
+    // reprodutive step split across worker threads
+    void ParallelReproductionStep();
+
     // record data step
     void RecordData();
 
+    // snapshot the current generation for data tracking
+    void TakeCensus(Census & snap);
+
+    // fill data nodes, find tracked solutions and write/print (only touches the census)
+    void AnalyzeCensus();
+
+    // lineage step (phylo.csv rows on the DATA_SAMPLING schedule, snapshots every SNAP_INTERVAL)
+    void LineageStep();
+
+    // population snapshot step (every SNAP_INTERVAL generations with POP_SNAP, written in the background)
+    void SnapshotStep();
+
+    // checkpoint step (every SNAP_INTERVAL generations, written in the background)
+    void CheckpointStep();
+
+    // snapshot everything needed to carry on from the next generation
+    void TakeCheckpoint(Checkpoint & ckpt);
+
 
     ///< selection scheme implementations
 
@@ -201,19 +308,19 @@ class DiagWorld : public emp::World<Org>
 
     ///< data tracking
 
-    size_t UniqueObjective();
-
-    size_t FindElite();
-
-    size_t FindCommon();
+    void SnapshotPhylogony();
 
-    size_t FindOptimized();
+    void SnapshotConfig(const config_t & config);
 
-    size_t FindUniqueStart();
+    // write why and when the run stopped
+    void SnapshotTermination();
 
-    void SnapshotPhylogony();
+    // register a data column with data.csv and/or data.col (DATA_FORMAT)
+    template <typename T>
+    void AddColumn(const std::function<T()> & fun, const std::string & key, const std::string & desc);
 
-    void SnapshotConfig(const config_t & config);
+    // write the current row to data.csv and/or data.col
+    void WriteRow();
 
     ///< helper functions
 
@@ -223,6 +330,74 @@ class DiagWorld : public emp::World<Org>
     // create matrix of population genomes
     gmatrix_t PopGenomes();
 
+    ///< migration
+
+    /**
+     * Emigrate function:
+     *
+     * Copies of evaluated solutions leaving for another island.
+     * Copies share genome and phenotype storage with the solutions that stay.
+     *
+     * @param cnt Number of emigrants.
+     * @param elite Send the best aggregate scores (ties to lowest id) instead of a random sample?
+     *
+     * @return Emigrant copies.
+     */
+    emp::vector<Org> Emigrate(const size_t cnt, const bool elite);
+
+    /**
+     * Immigrate function:
+     *
+     * Evaluated solutions arriving from another island replace the worst aggregate scores (ties to lowest id).
+     *
+     * @param orgs Immigrants.
+     */
+    void Immigrate(const emp::vector<Org> & orgs);
+
+    // immigrants that arrive as bare genomes (e.g. over MPI) are evaluated here first
+    void Immigrate(const gmatrix_t & genomes);
+
+    // last recorded generation (waits for background recording to finish)
+    const Census & GetCensus() {if(pipe) {pipe->Wait();} return census;}
+
+    // did a termination criterion fire by the last recorded generation? (waits like GetCensus)
+    // islands keep running after that until their driver Interrupts every island at the same generation
+    bool Stopped() {if(pipe) {pipe->Wait();} return !stop_reason.empty();}
+    const std::string & GetStopReason() {if(pipe) {pipe->Wait();} return stop_reason;}
+
+    // end the run at the next recorded generation, for reason unless a criterion already fired
+    // ("signal" is not a finished run, island drivers pick one generation for every island)
+    void Interrupt(const std::string & reason = "signal") {if(pipe) {pipe->Wait();} interrupted = true; interrupt_reason = reason;}
+
+    // termination.h var, to add custom criteria (nullptr if no criterion is configured)
+    emp::Ptr<Termination> GetTermination() {return termination;}
+
+    // apply the configured mutation operator to an offspring
+    size_t Mutate(Org & org, Mutation & mut);
+
+    // turn an offspring into a clone of its parent or reset its phenotype, given its mutation count
+    void FinishOffspring(Org & org, const size_t parent_pos, const size_t mcnt);
+
+    // place an offspring of parent_pos where the population structure puts it (dropped without a valid position, like DoBirth)
+    void PlaceOffspring(emp::Ptr<Org> offspring, const size_t parent_pos);
+
+    // point the counter-based stream at (current generation, phase, id) if we are using streams
+    void KeyStream(const uint32_t phase, const size_t id) {if(stream) {stream->Key(GetUpdate(), phase, id);}}
+
+    // allocation tag, counters, timer and span for a phase of the generation
+    // (does nothing without the alloccheck build, COUNTERS, TIMING_INTERVAL or TRACE_GENS)
+    Probe Time(const size_t phase)
+    {
+      return {Alloc::PhaseTag(phase), counters ? counters->Count(phase) : Counters::Sample(), timing ? timing->Time(phase) : Timer(), Mark(Timing::Name(phase), "phase")};
+    }
+
+    // trace span for this generation, or for gen on other threads (does nothing outside the TRACE_GENS window)
+    Trace::Span Mark(const char * name, const char * cat) {return Mark(name, cat, GetUpdate());}
+    Trace::Span Mark(const char * name, const char * cat, const size_t gen) {return trace ? trace->Scope(name, cat, gen) : Trace::Span();}
+
+    // label the calling thread in the trace (only while it is tracing gen)
+    void NameThread(const std::string & name, const size_t gen) {if(trace && trace->Covers(gen)) {trace->NameThread(trace_pid, name);}}
+
 
   private:
     // experiment configurations
@@ -236,53 +411,105 @@ class DiagWorld : public emp::World<Org>
     score_t fit_vec;
     // vector holding parent solutions selected by selection scheme
     ids_t parent_vec;
+    // vector holding which solutions were evaluated this generation (clones are not)
+    emp::vector<bool> eval_vec;
+    // vector holding how many objectives the selection scheme used per solution (by position id)
+    ids_t obj_vec;
 
 
     // evaluation lambda we set
     eval_t evaluate;
     // selection lambda we set
     sele_t select;
+    // migration hook (only set by island.h)
+    migr_t migrate;
+    // progress lines (std::cout by default)
+    Logger log{std::cout};
+    // setup messages and errors
+    Logger note{std::cerr};
 
 
+    // mutation.h var
+    emp::Ptr<Mutation> mutation;
     // select.h var
     emp::Ptr<Selection> selection;
+    // stream.h var (only used with RNG_STREAMS)
+    emp::Ptr<Stream> stream = nullptr;
+    // pool.h var (only used with THREADS > 1)
+    emp::Ptr<Pool> pool = nullptr;
+    // mutation operator and stream per worker
+    emp::vector<emp::Ptr<Mutation>> worker_muts;
+    emp::vector<emp::Ptr<Stream>> worker_streams;
+    // offspring slots filled by the workers
+    emp::vector<emp::Ptr<Org>> offspring_vec;
+    // our OnOffspringReady action count and mutation function type (workers only stand in for those)
+    size_t ready_actions = 0;
+    const std::type_info * mut_fun_type = nullptr;
+    // pipe.h var (only used with PIPELINE)
+    emp::Ptr<Pipe> pipe = nullptr;
+    // background checkpoint writer (only used with SNAP_INTERVAL > 0)
+    emp::Ptr<Pipe> saver = nullptr;
+    // checkpoint we are resuming from (only set while setting up)
+    emp::Ptr<Checkpoint> resume;
+    // termination.h var (only used if a criterion is configured)
+    emp::Ptr<Termination> termination = nullptr;
+    // timing.h var (only used with TIMING_INTERVAL > 0)
+    emp::Ptr<Timing> timing = nullptr;
+    // time the pipe thread spent analyzing the last census (handed to timing once the pipe is waited on)
+    uint64_t analyze_ns = 0;
+    // counters.h var (only used with COUNTERS)
+    emp::Ptr<Counters> counters = nullptr;
+    // lineage.h var (only used with PHYLO)
+    emp::Ptr<Lineage> lineage = nullptr;
+    // sampler.h var (generations that get a data row)
+    emp::Ptr<Sampler> sampler = nullptr;
+    // trace.h var (only used with TRACE_GENS > 0, shared by every island of an island model)
+    emp::Ptr<Trace> trace = nullptr;
+    bool trace_shared = false;
+    // pid our threads are grouped under in the trace
+    size_t trace_pid = 0;
     // problem.h var
     emp::Ptr<Diagnostic> diagnostic;
 
     ///< data file & node related variables
 
+    // stream behind the data file, writing through data_buf or data_async (appended to when resuming)
+    std::ostream data_stream{nullptr};
+    std::filebuf data_buf;
+    // writer thread behind data_stream (only used with WRITE_BUFFER > 0)
+    emp::Ptr<AsyncFile> data_async = nullptr;
     // file we are working with
     emp::DataFile data_file;
-    // systematics tracking
-    // emp::Ptr<systematics_t> sys_ptr;
-    // node to track population fitnesses
-    nodef_t pop_fit;
-    // node to track population opitmized count
-    nodeo_t pop_opti;
-    // node to track parent fitnesses
-    nodef_t pnt_fit;
-    // node to track parent optimized count
-    nodeo_t pnt_opti;
+    // binary columnar twin of the data file (only used with DATA_FORMAT > 0)
+    emp::Ptr<ColumnWriter> columns = nullptr;
 
     ///< data we are tracking during an evolutionary run
 
-    // elite solution position
-    size_t elite_pos;
-    // common solution position
-    size_t comm_pos;
-    // optimal solution position
-    size_t opti_pos;
-    // common solution dictionary
-    como_t common;
+    // generation snapshot being recorded
+    Census census;
+    // statistics of the census (only what this generation's outputs need)
+    Metrics metrics;
+    // solutions evaluated so far (clones skip evaluation)
+    size_t evals = 0;
+    // objective evaluations so far (only the objectives selection used count, e.g. a down sample)
+    size_t obj_evals = 0;
+    // why the run stopped early (empty while running) and the generation it did
+    std::string stop_reason = "";
+    size_t stop_update = 0;
+    // set by Interrupt
+    bool interrupted = false;
+    std::string interrupt_reason = "";
+    // the last generation was recorded (its row, log line and termination.csv only go out once)
+    bool finished = false;
 };
 
 ///< functions called to setup the world
 
 void DiagWorld::Initialize()
 {
-  std::cerr << "==========================================" << std::endl;
-  std::cerr << "BEGINNING INITIAL SETUP" << std::endl;
-  std::cerr << "==========================================" << std::endl;
+  note.Info() << "==========================================" << std::endl;
+  note.Info() << "BEGINNING INITIAL SETUP" << std::endl;
+  note.Info() << "==========================================" << std::endl;
 
   // reset the world upon start
   Reset();
@@ -293,35 +520,55 @@ void DiagWorld::Initialize()
   // stuff we need to initialize for the experiment
   SetEvaluation();
   SetMutation();
+  SetThreads();
   SetOnUpdate();
   SetDataTracking();
+  SetPipeline();
+  SetCheckpoints();
+  SetTermination();
+  SetTiming();
+  SetTracing();
+  SetCounters();
+  SetLineage();
   SetSelection();
   SetOnOffspringReady();
   PopulateWorld();
 
   SnapshotConfig(config);
 
-  std::cerr << "==========================================" << std::endl;
-  std::cerr << "FINISHED INITIAL SETUP" << std::endl;
-  std::cerr << "==========================================" << std::endl;
+  note.Info() << "==========================================" << std::endl;
+  note.Info() << "FINISHED INITIAL SETUP" << std::endl;
+  note.Info() << "==========================================" << std::endl;
+  note.Flush();
 }
 
 void DiagWorld::SetOnUpdate()
 {
-  std::cerr << "------------------------------------------------" << std::endl;
-  std::cerr << "Setting OnUpdate function..." << std::endl;
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting OnUpdate function..." << std::endl;
 
   // set up the evolutionary algorithm
   OnUpdate([this](size_t gen)
   {
+    NameThread("main", gen);
+
+    // counters follow the thread that opens them, so they start with the first generation
+    if(counters && !counters->Tried())
+    {
+      if(!counters->Open()) {note.Warn() << "HARDWARE COUNTERS UNAVAILABLE, NO counters.csv (" << counters->GetError() << ")" << std::endl;}
+      else if(!counters->GetError().empty()) {note.Warn() << "Some hardware counters are unavailable and left NA (" << counters->GetError() << ")" << std::endl;}
+    }
+
+    Probe whole = Time(Timing::GENERATION);
+
     // step 0: reset all data collection variables
     ResetData();
 
     // step 1: evaluate all solutions on diagnostic
     EvaluationStep();
 
-    // take a snapshot if nessecaryn (ask if appropiate place to take snapshot)
-    // if(GetUpdate() == config.MAX_GENS() - 1){SnapshotPhylogony();}
+    // step 1.5: swap evaluated solutions with other islands (if any)
+    if(migrate) {Probe t = Time(Timing::MIGRATE); migrate();}
 
     // step 2: select parent solutions for
     SelectionStep();
@@ -331,68 +578,93 @@ void DiagWorld::SetOnUpdate()
 
     // step 4: reproduce and create new solutions
     ReproductionStep();
+
+    // step 5: move the lineage table on to the offspring
+    LineageStep();
+
+    // step 6: population snapshot and checkpoint before the next generation (if it is time)
+    SnapshotStep();
+    CheckpointStep();
+
+    // step 7: timing rows (if it is time)
+    whole.Stop();
+    if(timing) {timing->Step(gen);}
   });
 
-  std::cerr << "Finished setting the OnUpdate function! \n" << std::endl;
+  note.Info() << "Finished setting the OnUpdate function! \n" << std::endl;
 }
 
 void DiagWorld::SetMutation()
 {
-  std::cerr << "------------------------------------------------" << std::endl;
-  std::cerr << "Setting mutation function..." << std::endl;
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting mutation function..." << std::endl;
+
+  mutation = emp::NewPtr<Mutation>(random_ptr);
+  mutation->SetStream(stream);
+  note.Debug() << "Created mutation emp::Ptr" << std::endl;
+
+  if(config.MUTATE_SKIP()) {note.Info() << "Mutating with geometric skips between mutated genes" << std::endl;}
+  else {note.Info() << "Mutating with a coin flip per gene" << std::endl;}
 
   // set the mutation function
   SetMutFun([this](Org & org, emp::Random & random)
   {
-    // number of mutations and solution genome
-    size_t mcnt = 0;
-    genome_t & genome = org.GetGenome();
-
     // quick checks
-    emp_assert(genome.size() == config.OBJECTIVE_CNT());
+    emp_assert(org.GetGenome().size() == config.OBJECTIVE_CNT());
     emp_assert(target.size() == config.OBJECTIVE_CNT());
 
-    for(size_t i = 0; i < genome.size(); ++i)
-    {
-      // if we do a mutation at this objective
-      if(random_ptr->P(config.MUTATE_PER()))
-      {
-        const double mut = random_ptr->GetRandNormal(config.MEAN(), config.STD());
-
-        // mutation puts objective above target
-        if(config.TARGET() < genome[i] + mut)
-        {
-          // we wrap it back around target value (discuss with Charles)
-          genome[i] = target[i] - (genome[i] + mut - target[i]);
-        }
-        // mutation puts objective in the negatives (discuss with Charles)
-        else if(genome[i] + mut < 0.0)
-        {
-          genome[i] = 0.0;
-        }
-        else
-        {
-          // else we can simply add mutation
-          genome[i] = genome[i] + mut;
-        }
-
-        ++mcnt;
-      }
-    }
-
-    return mcnt;
+    return Mutate(org, *mutation);
   });
+  mut_fun_type = &fun_do_mutations.target_type();
+
+  note.Info() << "Mutation function set!\n" << std::endl;
+}
+
+void DiagWorld::SetThreads()
+{
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting reproduction threads..." << std::endl;
+
+  // quick checks
+  emp_assert(0 < config.THREADS());
+
+  if(config.THREADS() < 2)
+  {
+    note.Info() << "Reproducing on the main thread only!\n" << std::endl;
+    return;
+  }
 
-  std::cerr << "Mutation function set!\n" << std::endl;
+  // without keyed streams the offspring would depend on which thread made them
+  if(!config.RNG_STREAMS())
+  {
+    note.Warn() << "THREADS > 1 REQUIRES RNG_STREAMS, REPRODUCING ON THE MAIN THREAD ONLY" << std::endl;
+    note.Info() << "Reproducing on the main thread only!\n" << std::endl;
+    return;
+  }
+
+  pool = emp::NewPtr<Pool>(config.THREADS());
+  note.Info() << "Created pool emp::Ptr with " << pool->GetSize() << " workers" << std::endl;
+
+  // every worker gets its own stream (same seed) and mutation operator drawing from it
+  for(size_t w = 0; w < pool->GetSize(); ++w)
+  {
+    worker_streams.push_back(emp::NewPtr<Stream>(static_cast<uint64_t>(config.SEED())));
+    worker_muts.push_back(emp::NewPtr<Mutation>(random_ptr));
+    worker_muts.back()->SetStream(worker_streams.back());
+  }
+  note.Debug() << "Created worker streams and mutation operators" << std::endl;
+
+  note.Info() << "Reproduction threads set!\n" << std::endl;
 }
 
 void DiagWorld::SetSelection()
 {
-  std::cerr << "------------------------------------------------" << std::endl;
-  std::cerr << "Setting Selection function..." << std::endl;
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting Selection function..." << std::endl;
 
   selection = emp::NewPtr<Selection>(random_ptr);
-  std::cerr << "Created selection emp::Ptr" << std::endl;
+  selection->SetStream(stream);
+  note.Debug() << "Created selection emp::Ptr" << std::endl;
 
   switch (config.SELECTION())
   {
@@ -429,18 +701,18 @@ void DiagWorld::SetSelection()
       break;
 
     default:
-      std::cerr << "ERROR UNKNOWN SELECTION CALL" << std::endl;
+      note.Error() << "ERROR UNKNOWN SELECTION CALL" << std::endl;
       emp_assert(true);
       break;
   }
 
-  std::cerr << "Finished setting the Selection function! \n" << std::endl;
+  note.Info() << "Finished setting the Selection function! \n" << std::endl;
 }
 
 void DiagWorld::SetOnOffspringReady()
 {
-  std::cerr << "------------------------------------------------" << std::endl;
-  std::cerr << "Setting OnOffspringReady function..." << std::endl;
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting OnOffspringReady function..." << std::endl;
 
   OnOffspringReady([this](Org & org, size_t parent_pos)
   {
@@ -452,36 +724,24 @@ void DiagWorld::SetOnOffspringReady()
     // do mutations on offspring
     size_t mcnt = fun_do_mutations(org, *random_ptr);
 
-    // no mutations were applied to offspring
-    if(mcnt == 0)
-    {
-      Org & parent = *pop[parent_pos];
-
-      // quick checks
-      emp_assert(parent.GetGenome().size() == config.OBJECTIVE_CNT());
-      emp_assert(parent.GetM() == config.OBJECTIVE_CNT());
-
-      // give everything to offspring from parent
-      org.MeClone();
-      org.Inherit(parent.GetScore(), parent.GetOptimal(), parent.GetCount(), parent.GetAggregate(), parent.GetStart());
-    }
-    else{org.Reset();}
+    FinishOffspring(org, parent_pos, mcnt);
   });
+  ready_actions = offspring_ready_sig.GetNumActions();
 
-  std::cerr << "Finished setting OnOffspringReady function!\n" << std::endl;
+  note.Info() << "Finished setting OnOffspringReady function!\n" << std::endl;
 }
 
 void DiagWorld::SetEvaluation()
 {
-  std::cerr << "------------------------------------------------" << std::endl;
-  std::cerr << "Setting Evaluation function..." << std::endl;
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting Evaluation function..." << std::endl;
 
   target_t tar(config.OBJECTIVE_CNT(), config.TARGET());
   target.clear(); target.resize(config.OBJECTIVE_CNT());
   std::copy(tar.begin(), tar.end(), target.begin());
 
   diagnostic = emp::NewPtr<Diagnostic>(target, config.CREDIT());
-  std::cerr << "Created diagnostic emp::Ptr" << std::endl;
+  note.Debug() << "Created diagnostic emp::Ptr" << std::endl;
 
   switch (config.DIAGNOSTIC())
   {
@@ -506,205 +766,184 @@ void DiagWorld::SetEvaluation()
       break;
 
     default: // error, unknown diganotic
-      std::cerr << "ERROR: UNKNOWN DIAGNOSTIC" << std::endl;
+      note.Error() << "ERROR: UNKNOWN DIAGNOSTIC" << std::endl;
       emp_assert(true);
       break;
   }
 
-  std::cerr << "Evaluation function set!\n" <<std::endl;
+  note.Info() << "Evaluation function set!\n" <<std::endl;
 }
 
 void DiagWorld::SetDataTracking()
 {
-  std::cerr << "------------------------------------------------" << std::endl;
-  std::cerr << "Setting up data tracking..." << std::endl;
-
-  // systematic tracking (ask alex about it)
-  std::cerr << "Setting up systematics tracking..." << std::endl;
-
-  // sys_ptr = emp::NewPtr<systematics_t>([](const Org & o) {return o.GetGenome();});
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting up data tracking..." << std::endl;
 
-  // sys_ptr->AddSnapshotFun([](const taxon_t & taxon) {
-  //   return emp::to_string(taxon.GetData().GetFitness());
-  // }, "fitness", "Taxon fitness");
-
-  // sys_ptr->AddSnapshotFun([](const taxon_t & taxon) {
-  //   return emp::ToString(taxon.GetData().GetPhenotype());
-  // }, "phenotype", "Taxon Phenotype");
-
-  // sys_ptr->AddSnapshotFun([](const taxon_t & taxon) {
-  //   return emp::ToString(taxon.GetInfo());
-  // }, "genotype", "Taxon Genotype");
+  // a resumed run keeps the rows written before its checkpoint and appends after them
+  const std::string data_path = config.OUTPUT_DIR() + "data.csv";
+  if(config.DATA_FORMAT() == 1)
+  {
+    note.Info() << "Writing data.col only (DATA_FORMAT 1)" << std::endl;
+  }
+  else if(resume)
+  {
+    // Checkpoint::Check made sure data.csv holds at least this much
+    std::error_code err;
+    std::filesystem::resize_file(data_path, resume->data_bytes, err);
+    if(err) {note.Error() << "ERROR: COULD NOT TRIM " << data_path << ": " << err.message() << std::endl;}
 
-  // will add it to the world for tracking purposes
-  // AddSystematics(sys_ptr);
-  // summary stats (whatever resolution we want)
-  // SetupSystematicsFile(0, config.OUTPUT_DIR() + "systematics.csv").SetTimingRepeat(config.PRINT_INTERVAL());
+    note.Info() << "Appending to " << data_path << " after " << resume->data_bytes << " bytes" << std::endl;
+  }
 
-  // std::cerr << "Systematics tracking complete!" << std::endl;
+  // rows either go out on this thread or through the writer thread's ring buffer
+  if(config.DATA_FORMAT() != 1 && config.WRITE_BUFFER())
+  {
+    data_async = emp::NewPtr<AsyncFile>(data_path, config.WRITE_BUFFER() * 1024, resume != nullptr);
+    data_stream.rdbuf(data_async.Raw());
+    note.Info() << "Writing " << data_path << " on a writer thread (" << config.WRITE_BUFFER() << " KB buffer)" << std::endl;
+  }
+  else if(config.DATA_FORMAT() != 1)
+  {
+    data_buf.open(data_path, resume ? std::ios::app : std::ios::out);
+    data_stream.rdbuf(&data_buf);
+  }
+  if(0 < config.DATA_FORMAT()) {columns = emp::NewPtr<ColumnWriter>();}
 
-  // initialize all nodes (ask charles)
-  std::cerr << "Initializing nodes..." << std::endl;
-  pop_fit.New(); pop_opti.New(); pnt_fit.New(); pnt_opti.New();
-  std::cerr << "Nodes initialized!" << std::endl;
+  // rows go out on the DATA_SAMPLING schedule (event sampling carries on watching from the checkpoint)
+  std::string err;
+  if(!Sampler::Check(config, err)) {note.Error() << "ERROR: " << err << std::endl;}
+  sampler = emp::NewPtr<Sampler>(config);
+  if(resume) {sampler->SetState(resume->sample_seen, resume->sample_opt, resume->sample_uni);}
+  note.Debug() << "Created sampler emp::Ptr" << std::endl;
+  note.Info() << "Writing data rows " << sampler->Describe() << std::endl;
 
   // track population aggregate score stats: average, variance, min, max
-  data_file.AddMean(*pop_fit, "pop_fit_avg", "Population average aggregate performance.");
-  data_file.AddVariance(*pop_fit, "pop_fit_var", "Population variance aggregate performance.");
-  data_file.AddMax(*pop_fit, "pop_fit_max", "Population maximum aggregate performance.");
-  data_file.AddMin(*pop_fit, "pop_fit_min", "Population minimum aggregate performance.");
+  AddColumn<double>([this]() {return metrics.PopFit().GetMean();}, "pop_fit_avg", "Population average aggregate performance.");
+  AddColumn<double>([this]() {return metrics.PopFit().GetVariance();}, "pop_fit_var", "Population variance aggregate performance.");
+  AddColumn<double>([this]() {return metrics.PopFit().GetMax();}, "pop_fit_max", "Population maximum aggregate performance.");
+  AddColumn<double>([this]() {return metrics.PopFit().GetMin();}, "pop_fit_min", "Population minimum aggregate performance.");
 
   // track population optimized objective count stats: average, variance, min, max
-  data_file.AddMean(*pop_opti, "pop_opt_avg", "Population average objective optimization count.");
-  data_file.AddVariance(*pop_opti, "pop_opt_var", "Population variance objective optimization count.");
-  data_file.AddMax(*pop_opti, "pop_opt_max", "Population maximum objective optimization count.");
-  data_file.AddMin(*pop_opti, "pop_opt_min", "Population minimum objective optimization count.");
+  AddColumn<double>([this]() {return metrics.PopOpti().GetMean();}, "pop_opt_avg", "Population average objective optimization count.");
+  AddColumn<double>([this]() {return metrics.PopOpti().GetVariance();}, "pop_opt_var", "Population variance objective optimization count.");
+  AddColumn<double>([this]() {return metrics.PopOpti().GetMax();}, "pop_opt_max", "Population maximum objective optimization count.");
+  AddColumn<double>([this]() {return metrics.PopOpti().GetMin();}, "pop_opt_min", "Population minimum objective optimization count.");
 
   // track parent aggregate score stats: average, variance, min, max
-  data_file.AddMean(*pnt_fit, "pnt_fit_avg", "Parent average aggregate performance.");
-  data_file.AddVariance(*pnt_fit, "pnt_fit_var", "Parent variance aggregate performance.");
-  data_file.AddMax(*pnt_fit, "pnt_fit_max", "Parent maximum aggregate performance.");
-  data_file.AddMin(*pnt_fit, "pnt_fit_min", "Parent minimum aggregate performance.");
+  AddColumn<double>([this]() {return metrics.PntFit().GetMean();}, "pnt_fit_avg", "Parent average aggregate performance.");
+  AddColumn<double>([this]() {return metrics.PntFit().GetVariance();}, "pnt_fit_var", "Parent variance aggregate performance.");
+  AddColumn<double>([this]() {return metrics.PntFit().GetMax();}, "pnt_fit_max", "Parent maximum aggregate performance.");
+  AddColumn<double>([this]() {return metrics.PntFit().GetMin();}, "pnt_fit_min", "Parent minimum aggregate performance.");
 
   // track parent optimized objective count stats: average, variance, min, max
-  data_file.AddMean(*pnt_opti, "pnt_opt_avg", "Parent average objective optimization count.");
-  data_file.AddVariance(*pnt_opti, "pnt_opt_var", "Parent variance objective optimization count.");
-  data_file.AddMax(*pnt_opti, "pnt_opt_max", "Parent maximum objective optimization count.");
-  data_file.AddMin(*pnt_opti, "pnt_opt_min", "Parent minimum objective optimization count.");
+  AddColumn<double>([this]() {return metrics.PntOpti().GetMean();}, "pnt_opt_avg", "Parent average objective optimization count.");
+  AddColumn<double>([this]() {return metrics.PntOpti().GetVariance();}, "pnt_opt_var", "Parent variance objective optimization count.");
+  AddColumn<double>([this]() {return metrics.PntOpti().GetMax();}, "pnt_opt_max", "Parent maximum objective optimization count.");
+  AddColumn<double>([this]() {return metrics.PntOpti().GetMin();}, "pnt_opt_min", "Parent minimum objective optimization count.");
 
-  std::cerr << "Added all data nodes to data file!" << std::endl;
+  note.Info() << "Added all data nodes to data file!" << std::endl;
 
   // update we are at
-  data_file.AddFun<size_t>([this]()
+  AddColumn<size_t>([this]()
   {
-    return update;
+    return census.update;
   }, "gen", "Current generation at!");
 
   // unique optimized objectives count
-  data_file.AddFun<size_t>([this]()
+  AddColumn<size_t>([this]()
   {
-    return UniqueObjective();
+    return metrics.GetUniqueObjective();
   }, "pop_uni_obj", "Number of unique optimized traits per generation!");
 
     // unique starting positions
-  data_file.AddFun<size_t>([this]()
+  AddColumn<size_t>([this]()
   {
-    return FindUniqueStart();
+    return metrics.GetUniqueStart();
   }, "uni_str_pos", "Number of unique starting positions in the population!");
 
   // count of common solution in the population
-  data_file.AddFun<size_t>([this]()
+  AddColumn<size_t>([this]()
   {
-    // quick checks
-    emp_assert(0 < common.size());
-    emp_assert(comm_pos != config.POP_SIZE());
-
-    // find iterator to common org
-    const auto it = common.find(comm_pos);
-    emp_assert(it != common.end());
-    emp_assert(0 < it->second.size());
-
-    return it->second.size();
+    return metrics.GetCommonCount();
   }, "com_sol_cnt", "Count of genetically common solution!");
 
   // elite solution aggregate performance
-  data_file.AddFun<double>([this]()
+  AddColumn<double>([this]()
   {
     // quick checks
-    emp_assert(elite_pos != config.POP_SIZE());
-    emp_assert(pop.size() == config.POP_SIZE());
-
-    Org & org = *pop[elite_pos];
+    emp_assert(census.agg.size() == config.POP_SIZE());
 
-    return org.GetAggregate();
+    return census.agg[metrics.GetElite()];
   }, "ele_agg_per", "Elite solution aggregate performance!");
 
   // elite solution optimized objectives count
-  data_file.AddFun<size_t>([this]()
+  AddColumn<size_t>([this]()
   {
     // quick checks
-    emp_assert(elite_pos != config.POP_SIZE());
-    emp_assert(pop.size() == config.POP_SIZE());
-
-    Org & org = *pop[elite_pos];
+    emp_assert(census.count.size() == config.POP_SIZE());
 
-    return org.GetCount();
+    return census.count[metrics.GetElite()];
   }, "ele_opt_cnt", "Elite solution optimized objective count!");
 
   // common solution aggregate performance
-  data_file.AddFun<double>([this]()
+  AddColumn<double>([this]()
   {
     // quick checks
-    emp_assert(comm_pos != config.POP_SIZE());
-    emp_assert(pop.size() == config.POP_SIZE());
+    emp_assert(census.agg.size() == config.POP_SIZE());
 
-    Org & org = *pop[comm_pos];
-
-    return org.GetAggregate();
+    return census.agg[metrics.GetCommon()];
   }, "com_agg_per", "Common solution aggregate performance!");
 
   // common solution optimized objectives count
-  data_file.AddFun<size_t>([this]()
+  AddColumn<size_t>([this]()
   {
     // quick checks
-    emp_assert(comm_pos != config.POP_SIZE());
-    emp_assert(pop.size() == config.POP_SIZE());
-
-    Org & org = *pop[comm_pos];
+    emp_assert(census.count.size() == config.POP_SIZE());
 
-    return org.GetCount();
+    return census.count[metrics.GetCommon()];
   }, "com_opt_cnt", "Common solution optimized objective count!");
 
   // optimized solution aggregate performance
-  data_file.AddFun<double>([this]()
+  AddColumn<double>([this]()
   {
     // quick checks
-    emp_assert(opti_pos != config.POP_SIZE());
-    emp_assert(pop.size() == config.POP_SIZE());
+    emp_assert(census.agg.size() == config.POP_SIZE());
 
-    Org & org = *pop[opti_pos];
-
-    return org.GetAggregate();
+    return census.agg[metrics.GetOptimized()];
   }, "opt_agg_per", "Otpimal solution aggregate performance");
 
   // optimized solution optimized objectives count
-  data_file.AddFun<size_t>([this]()
+  AddColumn<size_t>([this]()
   {
     // quick checks
-    emp_assert(opti_pos != config.POP_SIZE());
-    emp_assert(pop.size() == config.POP_SIZE());
-
-    Org & org = *pop[opti_pos];
+    emp_assert(census.count.size() == config.POP_SIZE());
 
-    return org.GetCount();
+    return census.count[metrics.GetOptimized()];
   }, "opt_obj_cnt", "Otpimal solution aggregate performance");
 
   // loss of diversity
-  data_file.AddFun<double>([this]()
+  AddColumn<double>([this]()
   {
     // quick checks
-    emp_assert(parent_vec.size() == config.POP_SIZE());
-
-    std::set<size_t> unique;
-    for(auto & id : parent_vec) {unique.insert(id);}
+    emp_assert(census.parents.size() == config.POP_SIZE());
 
     // ask Charles
-    const double num = static_cast<double>(unique.size());
+    const double num = static_cast<double>(metrics.GetUniqueParent());
     const double dem = static_cast<double>(config.POP_SIZE());
 
     return num / dem;
   }, "los_div", "Loss in diversity generated by the selection scheme!");
 
   // selection pressure
-  data_file.AddFun<double>([this]()
+  AddColumn<double>([this]()
   {
     // quick checks
-    emp_assert(pop_fit->GetCount() == config.POP_SIZE());
-    emp_assert(pnt_fit->GetCount() == config.POP_SIZE());
+    emp_assert(metrics.PopFit().GetCount() == config.POP_SIZE());
+    emp_assert(metrics.PntFit().GetCount() == config.POP_SIZE());
 
-    const double pop = pop_fit->GetMean();
-    const double pnt = pnt_fit->GetMean();
-    const double var = pop_fit->GetVariance();
+    const double pop = metrics.PopFit().GetMean();
+    const double pnt = metrics.PntFit().GetMean();
+    const double var = metrics.PopFit().GetVariance();
 
     if(var == 0.0) {return 0.0;}
 
@@ -712,35 +951,242 @@ void DiagWorld::SetDataTracking()
   }, "sel_pre", "Selection pressure applied by selection scheme!");
 
   // selection variance
-  data_file.AddFun<double>([this]()
+  AddColumn<double>([this]()
   {
     // quick checks
-    emp_assert(pop_fit->GetCount() == config.POP_SIZE());
-    emp_assert(pnt_fit->GetCount() == config.POP_SIZE());
+    emp_assert(metrics.PopFit().GetCount() == config.POP_SIZE());
+    emp_assert(metrics.PntFit().GetCount() == config.POP_SIZE());
 
-    const double pop = pop_fit->GetVariance();
-    const double pnt = pnt_fit->GetVariance();
+    const double pop = metrics.PopFit().GetVariance();
+    const double pnt = metrics.PntFit().GetVariance();
 
     if(pnt == 0.0) {return 0.0;}
 
     return pop / pnt;
   }, "sel_var", "Selection pressure applied by selection scheme!");
 
-  data_file.PrintHeaderKeys();
+  // evaluation accounting (clones skip evaluation and are not counted)
+  AddColumn<size_t>([this]()
+  {
+    return census.evals;
+  }, "sol_evals", "Solutions evaluated so far!");
+
+  AddColumn<size_t>([this]()
+  {
+    return census.obj_evals;
+  }, "obj_evals", "Objective evaluations so far (only objectives used by the selection scheme count)!");
+
+  // distinct genomes in the population
+  AddColumn<size_t>([this]()
+  {
+    return metrics.GetUniqueGenotype();
+  }, "pop_uni_gen", "Number of distinct genotypes in the population!");
 
-  std::cerr << "Finished setting data tracking!\n" << std::endl;
+  // distinct score vectors in the population
+  AddColumn<size_t>([this]()
+  {
+    return metrics.GetUniquePhenotype();
+  }, "pop_uni_phe", "Number of distinct phenotypes (score vectors) in the population!");
+
+  if(!resume && config.DATA_FORMAT() != 1) {data_file.PrintHeaderKeys();}
+
+  // data.col picks up after the checkpoint's last block, like data.csv does
+  if(columns)
+  {
+    const std::string col_path = config.OUTPUT_DIR() + "data.col";
+    if(!columns->Open(col_path, resume ? resume->col_bytes : 0)) {note.Error() << "ERROR: COULD NOT OPEN " << col_path << std::endl;}
+    note.Info() << "Writing " << columns->GetKeys().size() << " columns to " << col_path << std::endl;
+  }
+
+  note.Info() << "Finished setting data tracking!\n" << std::endl;
+}
+
+void DiagWorld::SetPipeline()
+{
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting data recording..." << std::endl;
+
+  if(config.PIPELINE())
+  {
+    pipe = emp::NewPtr<Pipe>();
+    note.Info() << "Created pipe emp::Ptr, recording data in the background" << std::endl;
+  }
+  else
+  {
+    note.Info() << "Recording data on the main thread" << std::endl;
+  }
+
+  note.Info() << "Data recording set!\n" << std::endl;
+}
+
+void DiagWorld::SetCheckpoints()
+{
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting checkpoints..." << std::endl;
+
+  if(config.SNAP_INTERVAL() == 0)
+  {
+    note.Info() << "No checkpoints!\n" << std::endl;
+    return;
+  }
+
+  saver = emp::NewPtr<Pipe>();
+  note.Info() << "Created saver emp::Ptr, checkpointing to " << config.OUTPUT_DIR() << "checkpoint.bin every " << config.SNAP_INTERVAL() << " generations" << std::endl;
+  if(config.POP_SNAP()) {note.Info() << "Writing pop_<gen>.snap population snapshots every " << config.SNAP_INTERVAL() << " generations" << std::endl;}
+
+  note.Info() << "Checkpoints set!\n" << std::endl;
+}
+
+void DiagWorld::SetTermination()
+{
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting termination criteria..." << std::endl;
+
+  if(!Termination::Enabled(config))
+  {
+    note.Info() << "Running until MAX_GENS!\n" << std::endl;
+    return;
+  }
+
+  termination = emp::NewPtr<Termination>(config);
+  note.Debug() << "Created termination emp::Ptr" << std::endl;
+
+  if(config.STOP_OPTIMIZED()) {note.Info() << "Stopping once every objective is optimized" << std::endl;}
+  if(config.STAG_GENS()) {note.Info() << "Stopping after " << config.STAG_GENS() << " generations without " << (config.STAG_METRIC() ? "pop_uni_obj" : "ele_agg_per") << " improving" << std::endl;}
+  if(config.MAX_EVALS()) {note.Info() << "Stopping after " << config.MAX_EVALS() << " objective evaluations" << std::endl;}
+  if(0.0 < config.MAX_SECONDS()) {note.Info() << "Stopping after " << config.MAX_SECONDS() << " seconds" << std::endl;}
+
+  // stagnation picks up where the checkpoint left it
+  if(resume && config.STAG_GENS()) {termination->SetStagnation(resume->stag_best, resume->stag_since);}
+
+  note.Info() << "Termination criteria set!\n" << std::endl;
+}
+
+void DiagWorld::SetTiming()
+{
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting timing..." << std::endl;
+
+  if(config.TIMING_INTERVAL() == 0)
+  {
+    note.Info() << "No timing!\n" << std::endl;
+    return;
+  }
+
+  // a resumed run keeps the rows from before its checkpoint
+  timing = emp::NewPtr<Timing>(config.OUTPUT_DIR() + "timing.csv", config.TIMING_INTERVAL(), resume ? resume->update : 0);
+  note.Info() << "Created timing emp::Ptr, writing " << config.OUTPUT_DIR() << "timing.csv every " << config.TIMING_INTERVAL() << " generations" << std::endl;
+
+  note.Info() << "Timing set!\n" << std::endl;
+}
+
+void DiagWorld::SetTracing()
+{
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting tracing..." << std::endl;
+
+  if(config.TRACE_GENS() == 0)
+  {
+    note.Info() << "No tracing!\n" << std::endl;
+    return;
+  }
+
+  trace = emp::NewPtr<Trace>(config.OUTPUT_DIR() + "trace.json", config.TRACE_FROM(), config.TRACE_GENS());
+  trace->NameProcess(trace_pid, "world");
+  note.Info() << "Created trace emp::Ptr, tracing generations " << config.TRACE_FROM() << " to " << config.TRACE_FROM() + config.TRACE_GENS() - 1 << " into " << config.OUTPUT_DIR() << "trace.json" << std::endl;
+
+  note.Info() << "Tracing set!\n" << std::endl;
+}
+
+void DiagWorld::SetCounters()
+{
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting hardware counters..." << std::endl;
+
+  if(!config.COUNTERS())
+  {
+    note.Info() << "No hardware counters!\n" << std::endl;
+    return;
+  }
+
+  // opened by the thread running the generations (an island's own thread), once the first one starts
+  counters = emp::NewPtr<Counters>();
+  note.Info() << "Created counters emp::Ptr, writing " << config.OUTPUT_DIR() << "counters.csv at the end of the run" << std::endl;
+
+  note.Info() << "Hardware counters set!\n" << std::endl;
+}
+
+void DiagWorld::SetLineage()
+{
+  note.Info() << "------------------------------------------------" << std::endl;
+  note.Info() << "Setting lineage tracking..." << std::endl;
+
+  if(!config.PHYLO())
+  {
+    note.Info() << "No lineage tracking!\n" << std::endl;
+    return;
+  }
+
+  // a resumed run keeps the rows from before its checkpoint and carries on with its table
+  lineage = emp::NewPtr<Lineage>(config.OUTPUT_DIR() + "phylo.csv", config.POP_SIZE(), config.PHYLO_PHENOTYPE(), resume ? resume->update : 0);
+  note.Info() << "Created lineage emp::Ptr, writing " << config.OUTPUT_DIR() << "phylo.csv " << sampler->Describe() << std::endl;
+
+  if(resume)
+  {
+    // Checkpoint::Check made sure the checkpoint has a table
+    std::istringstream is(resume->lineage);
+    if(!lineage->Load(is))
+    {
+      note.Error() << "ERROR: LINEAGE TABLE IN THE CHECKPOINT DOES NOT FIT, EVERY SOLUTION STARTS A NEW ROOT" << std::endl;
+      lineage->Found(resume->update);
+    }
+  }
+  else {lineage->Found(0);}
+
+  if(config.SNAP_INTERVAL()) {note.Info() << "Writing phylo_<gen>.csv snapshots every " << config.SNAP_INTERVAL() << " generations" << std::endl;}
+  if(config.PHYLO_PHENOTYPE()) {note.Info() << "Keeping the score vector of every taxon" << std::endl;}
+
+  note.Info() << "Lineage tracking set!\n" << std::endl;
+}
+
+void DiagWorld::SetTrace(emp::Ptr<Trace> _trace, const size_t pid)
+{
+  if(trace && !trace_shared) {trace.Delete();}
+
+  trace = _trace;
+  trace_shared = true;
+  trace_pid = pid;
+  trace->NameProcess(pid, "island " + std::to_string(pid));
 }
 
 void DiagWorld::PopulateWorld()
 {
-  std::cerr << "------------------------------------------" << std::endl;
-  std::cerr << "Populating world with initial solutions..." << std::endl;
+  note.Info() << "------------------------------------------" << std::endl;
+  note.Info() << "Populating world with initial solutions..." << std::endl;
+
+  if(resume)
+  {
+    // quick checks
+    emp_assert(resume->genome.size() == config.POP_SIZE());
+
+    // same orgs at the same positions, picking up at the checkpoint's generation
+    for(size_t i = 0; i < resume->genome.size(); ++i)
+    {
+      AddOrgAt(emp::NewPtr<Org>(resume->MakeOrg(i)), emp::WorldPosition(i));
+    }
+    update = resume->update;
+    evals = resume->evals;
+    obj_evals = resume->obj_evals;
+
+    note.Info() << "Resumed world at generation " << update << "!" << std::endl;
+    return;
+  }
 
   // Fill the workd with requested population size!
   Org org(config.OBJECTIVE_CNT());
   Inject(org.GetGenome(), config.POP_SIZE());
 
-  std::cerr << "Initialing world complete!" << std::endl;
+  note.Info() << "Initialing world complete!" << std::endl;
 }
 
 
@@ -748,123 +1194,417 @@ void DiagWorld::PopulateWorld()
 
 void DiagWorld::ResetData()
 {
-  // reset all data nodes
-  pop_fit->Reset();
-  pop_opti->Reset();
-  pnt_fit->Reset();
-  pnt_opti->Reset();
-
-  // reset all positon ids
-  elite_pos = config.POP_SIZE();
-  comm_pos = config.POP_SIZE();
-  opti_pos = config.POP_SIZE();
-
-  // reset all vectors/maps holding current gen data
+  Probe t = Time(Timing::RESET);
+
+  // reset all vectors holding current gen data
+  // (metrics are cleared and recomputed when a census is analyzed)
   fit_vec.clear();
   parent_vec.clear();
-  common.clear();
+  eval_vec.clear();
+  obj_vec.clear();
 }
 
 void DiagWorld::EvaluationStep()
 {
+  Probe t = Time(Timing::EVALUATE);
+
   // quick checks
   emp_assert(fit_vec.size() == 0); emp_assert(0 < pop.size());
   emp_assert(pop.size() == config.POP_SIZE());
 
   // iterate through the world and populate fitness vector
   fit_vec.resize(config.POP_SIZE());
+  eval_vec.assign(config.POP_SIZE(), false);
+  Alloc::SiteTag site(Alloc::DIAGNOSTIC);
+  Trace::Span chunk;
   for(size_t i = 0; i < pop.size(); ++i)
   {
+    // traced in chunks, to see how evaluation cost varies across the population
+    if(i % Trace::CHUNK == 0) {chunk = Mark("evaluate chunk", "kernel");}
+
     Org & org = *pop[i];
 
     // no evaluate needed if offspring is a clone
-    fit_vec[i] = (org.GetClone()) ? org.GetAggregate() : evaluate(org);
-
-    // systematic stuff
-    // emp::Ptr<taxon_t> taxon = sys_ptr->GetTaxonAt(i);
-    // taxon->GetData().RecordFitness(org.GetAggregate());
-    // taxon->GetData().RecordPhenotype(org.GetScore());
+    if(org.GetClone()) {fit_vec[i] = org.GetAggregate();}
+    else {fit_vec[i] = evaluate(org); eval_vec[i] = true; ++evals;}
   }
 }
 
 void DiagWorld::SelectionStep()
 {
+  Probe t = Time(Timing::SELECT);
+
   // quick checks
   emp_assert(parent_vec.size() == 0); emp_assert(0 < pop.size());
   emp_assert(pop.size() == config.POP_SIZE());
 
+  // every objective counts, unless the selection scheme only looks at some of them
+  obj_vec.assign(config.POP_SIZE(), config.OBJECTIVE_CNT());
+
   // store parents
+  Probe scheme = Time(Timing::SELECTOR);
+  Alloc::SiteTag site(Alloc::SELECTION);
   auto parents = select();
+  scheme.Stop();
   emp_assert(parents.size() == config.POP_SIZE());
 
   parent_vec.resize(config.POP_SIZE());
   std::copy(parents.begin(), parents.end(), parent_vec.begin());
+
+  // charge the objectives used to every solution evaluated this generation
+  emp_assert(eval_vec.size() == config.POP_SIZE());
+  for(size_t i = 0; i < obj_vec.size(); ++i) {if(eval_vec[i]) {obj_evals += obj_vec[i];}}
 }
 
 void DiagWorld::RecordData()
 {
-  /// Add data to all nodes
+  Probe t = Time(Timing::RECORD);
 
-  // get pop data
+  // quick checks
   emp_assert(pop.size() == config.POP_SIZE());
-  for(size_t i = 0; i < pop.size(); ++i)
+  emp_assert(fit_vec.size() == config.POP_SIZE()); // should be set already
+  emp_assert(parent_vec.size() == config.POP_SIZE()); // should be set already
+
+  // record on the main thread
+  if(!pipe)
   {
-    Org & org = *pop[i];
-    pop_fit->Add(org.GetAggregate());
-    pop_opti->Add(org.GetCount());
+    TakeCensus(census);
+    Probe analyze = Time(Timing::ANALYZE);
+    AnalyzeCensus();
+    return;
   }
-  emp_assert(pop_fit->GetCount() == config.POP_SIZE());
-  emp_assert(pop_opti->GetCount() == config.POP_SIZE());
 
-  // get parent data
+  // snapshot while the last census may still be recording, then hand it over once the pipe is free
+  Census snap;
+  TakeCensus(snap);
+
+  // waiting here means the pipe thread is the bottleneck
+  Trace::Span wait = Mark("wait pipe", "stall");
+  pipe->Wait();
+  wait.End();
+  census = std::move(snap);
+
+  // the pipe thread only measures, its time is added here once it is idle again
+  if(timing && analyze_ns) {timing->Add(Timing::ANALYZE, analyze_ns);}
+  analyze_ns = 0;
+  pipe->Submit([this]()
+  {
+    NameThread("pipe", census.update);
+    Alloc::PhaseTag tag(Timing::ANALYZE);
+    Trace::Span span = Mark(Timing::Name(Timing::ANALYZE), "phase", census.update);
+    const auto start = timing ? Timer::clock_t::now() : Timer::clock_t::time_point();
+    AnalyzeCensus();
+    if(timing) {analyze_ns = Timer::Since(start);}
+  });
+}
+
+void DiagWorld::TakeCensus(Census & snap)
+{
+  // quick checks
+  emp_assert(pop.size() == config.POP_SIZE());
   emp_assert(parent_vec.size() == config.POP_SIZE());
-  for(size_t i = 0; i < parent_vec.size(); ++i)
+
+  snap.update = GetUpdate();
+  snap.agg.resize(pop.size()); snap.count.resize(pop.size()); snap.start.resize(pop.size());
+  snap.genome.resize(pop.size()); snap.score.resize(pop.size()); snap.optimal.resize(pop.size());
+
+  for(size_t i = 0; i < pop.size(); ++i)
   {
-    Org & org = *pop[parent_vec[i]];
-    pnt_fit->Add(org.GetAggregate());
-    pnt_opti->Add(org.GetCount());
+    Org & org = *pop[i];
+    snap.agg[i] = org.GetAggregate();
+    snap.count[i] = org.GetCount();
+    snap.start[i] = org.GetStart();
+    snap.genome[i] = org.ShareGenome();
+    snap.score[i] = org.ShareScore();
+    snap.optimal[i] = org.ShareOptimal();
   }
-  emp_assert(pnt_fit->GetCount() == config.POP_SIZE());
-  emp_assert(pnt_opti->GetCount() == config.POP_SIZE());
 
-  /// get all position ids
+  snap.parents = parent_vec;
+  snap.evals = evals;
+  snap.obj_evals = obj_evals;
+}
 
-  elite_pos = FindElite();
-  emp_assert(elite_pos != config.POP_SIZE());
+void DiagWorld::AnalyzeCensus()
+{
+  // quick checks
+  emp_assert(census.agg.size() == config.POP_SIZE());
+  emp_assert(census.parents.size() == config.POP_SIZE());
 
-  comm_pos = FindCommon();
-  emp_assert(comm_pos != config.POP_SIZE());
+  const bool scheduled = sampler->Scheduled(census.update);
+  // progress lines are also held back to at most one every LOG_SECONDS
+  const bool line = (!(census.update % config.PRINT_INTERVAL()) && log.Due(config.LOG_SECONDS())) || census.update == config.MAX_GENS();
 
-  opti_pos = FindOptimized();
-  emp_assert(opti_pos != config.POP_SIZE());
+  /// compute only what this generation's outputs need, in one pass
+  size_t need = Metrics::NONE;
+  if(scheduled) {need |= Metrics::ROW;}
+  if(line || termination || sampler->WatchesEvents()) {need |= Metrics::BEST;}
+  if((termination && termination->WatchesUnique()) || sampler->WatchesEvents()) {need |= Metrics::UNIQUE;}
 
-  /// fill vectors & map
-  emp_assert(fit_vec.size() == config.POP_SIZE()); // should be set already
-  emp_assert(parent_vec.size() == config.POP_SIZE()); // should be set already
-  emp_assert(0 < common.size());  // should already be set in FindCommon
+  metrics.Clear();
+  metrics.Compute(census, need);
+
+  // event sampling watches every generation, the row metrics are only computed when something moved
+  bool row = scheduled;
+  if(sampler->WatchesEvents() && sampler->Changed(census.count[metrics.GetOptimized()], metrics.GetUniqueObjective())) {row = true;}
+
+  /// check the stopping criteria first, so the last generation always gets a row
+  if(termination && stop_reason.empty())
+  {
+    Status status;
+    status.gen = census.update;
+    status.ele_agg = census.agg[metrics.GetElite()];
+    status.opt_cnt = census.count[metrics.GetOptimized()];
+    status.uni_obj = termination->WatchesUnique() ? metrics.GetUniqueObjective() : 0;
+    status.evals = census.evals;
+    status.obj_evals = census.obj_evals;
+
+    if(termination->Check(status)) {stop_reason = termination->GetReason(); stop_update = census.update;}
+  }
+  // a SIGINT or SIGTERM ends the run here, so the data files get their last row and are flushed on the way out
+  if(stop_reason.empty() && (interrupted || (!migrate && Termination::Signaled())))
+  {
+    stop_reason = interrupted ? interrupt_reason : "signal";
+    stop_update = census.update;
+  }
+  // islands run on after a criterion fires or a signal arrives until their driver Interrupts every island at the same generation,
+  // so no neighbor is left waiting on migrants
+  const bool last = !finished && ((census.update == config.MAX_GENS()) || (!stop_reason.empty() && (!migrate || interrupted)));
+  if(last) {finished = true;}
 
   /// update the file
-  if ( !(GetUpdate() % config.DATA_INTERVAL()) || (GetUpdate() == config.MAX_GENS()) ) {
-    data_file.Update();
+  if ( row || last ) {
+    // a run stopping early still gets its last row
+    metrics.Compute(census, Metrics::ROW);
+    WriteRow();
   }
 
-  if ( !(GetUpdate() % config.PRINT_INTERVAL()) || (GetUpdate() == config.MAX_GENS()) ) {
+  if ( line || last ) {
     // output this so we know where we are in terms of generations and fitness
-    Org & org = *pop[elite_pos];
-    Org & opt = *pop[opti_pos];
-    std::cout << "gen=" << GetUpdate() << ", max_fit=" << org.GetAggregate()  << ", max_opt=" << opt.GetCount() << std::endl;
+    log.Write(Logger::INFO, Logger::Record().Add("gen", census.update).Add("max_fit", census.agg[metrics.GetElite()]).Add("max_opt", census.count[metrics.GetOptimized()]));
+  }
+
+  if(last && !stop_reason.empty())
+  {
+    // an island's criterion may have fired before the generation every island stopped at
+    const std::string at = (stop_update == census.update) ? "" : " (met at gen=" + std::to_string(stop_update) + ")";
+    log.Write(Logger::INFO, Logger::Record("Stopped at gen=" + std::to_string(census.update) + ": " + stop_reason + at).Add("gen", census.update).Add("stop", stop_reason));
+  }
+
+  // an interrupted run is not finished, so it gets no termination.csv (and carries on from its checkpoint)
+  if(termination && last && stop_reason != "signal") {SnapshotTermination();}
+
+  // progress lines held through a quiet stretch still go out about once a second
+  log.Tick();
+}
+
+void DiagWorld::LineageStep()
+{
+  if(!lineage) {return;}
+  Probe t = Time(Timing::LINEAGE);
+
+  // quick checks
+  emp_assert(eval_vec.size() == config.POP_SIZE());
+  emp_assert(parent_vec.size() == config.POP_SIZE());
+
+  // taxa evaluated for the first time get their fitness
+  for(size_t i = 0; i < pop.size(); ++i) {if(eval_vec[i]) {lineage->Record(i, pop[i]->GetAggregate(), pop[i]->GetScore());}}
+
+  // rows and snapshots describe this generation, before the offspring take over
+  const size_t gen = GetUpdate();
+  if(sampler->Scheduled(gen)) {lineage->Row(gen);}
+  if(config.SNAP_INTERVAL() && !(gen % config.SNAP_INTERVAL()))
+  {
+    Trace::Span span = Mark("write phylogeny", "io");
+    lineage->Snapshot(config.OUTPUT_DIR() + "phylo_" + std::to_string(gen) + ".csv");
   }
 
+  // generations are synchronous, so the offspring wait in pops[1] until the update finishes
+  const pop_t & next = pops[1];
+  lineage->Birth(parent_vec, [&next](const size_t i) {return next[i]->GetClone();}, gen);
+}
+
+void DiagWorld::SnapshotStep()
+{
+  if(!saver || !config.POP_SNAP() || GetUpdate() % config.SNAP_INTERVAL()) {return;}
+  Probe t = Time(Timing::CHECKPOINT);
+
+  // quick checks
+  emp_assert(pop.size() == config.POP_SIZE());
+
+  // the evaluated population of this generation, shared with the orgs and written in the background
+  auto snap = std::make_shared<PopSnapshot>();
+  snap->gen = GetUpdate();
+  snap->seed = config.SEED();
+  snap->selection = config.SELECTION();
+  snap->diagnostic = config.DIAGNOSTIC();
+  snap->objective_cnt = config.OBJECTIVE_CNT();
+  for(size_t i = 0; i < pop.size(); ++i)
+  {
+    Org & org = *pop[i];
+    snap->Add(org.ShareGenome(), org.ShareScore(), org.ShareOptimal(), org.GetClone(), org.GetStart());
+  }
+
+  const std::string path = config.OUTPUT_DIR() + "pop_" + std::to_string(GetUpdate()) + ".snap";
+  saver->Submit([this, snap, path]()
+  {
+    NameThread("saver", snap->gen);
+    Trace::Span span = Mark("write snapshot", "io", snap->gen);
+    Alloc::PhaseTag tag(Timing::CHECKPOINT);
+    snap->Write(path);
+  });
+}
+
+void DiagWorld::CheckpointStep()
+{
+  // checkpoints are taken at the end of a generation for the one after it
+  const size_t next = GetUpdate() + 1;
+  if(!saver || next % config.SNAP_INTERVAL() || config.MAX_GENS() < next) {return;}
+
+  // a stopped run never gets to the next generation
+  if(Stopped()) {return;}
+
+  // migrants in flight are not part of a world, so island runs are not checkpointed
+  if(migrate) {return;}
+  Probe t = Time(Timing::CHECKPOINT);
+
+  // snapshot on the main thread (shares org storage), write in the background
+  auto ckpt = std::make_shared<Checkpoint>();
+  TakeCheckpoint(*ckpt);
+
+  const std::string path = config.OUTPUT_DIR() + "checkpoint.bin";
+  saver->Submit([this, ckpt, path, gen = GetUpdate()]()
+  {
+    NameThread("saver", gen);
+    Trace::Span span = Mark("write checkpoint", "io", gen);
+    Alloc::PhaseTag tag(Timing::CHECKPOINT);
+    ckpt->Write(path);
+  });
+}
+
+void DiagWorld::TakeCheckpoint(Checkpoint & ckpt)
+{
+  // generations are synchronous, so the offspring wait in pops[1] until the update finishes
+  const pop_t & next = pops[1];
+
+  // quick checks
+  emp_assert(next.size() == config.POP_SIZE());
+
+  // every row up to this generation has to be in data.csv before we measure it
+  if(pipe) {pipe->Wait();}
+  Trace::Span flush = Mark("flush data", "io");
+  data_stream.flush();
+  if(data_async) {data_async->Flush();}
+  if(columns) {columns->Flush(); ckpt.col_bytes = columns->GetBytes();}
+  flush.End();
+  std::error_code err;
+  const auto size = std::filesystem::file_size(config.OUTPUT_DIR() + "data.csv", err);
+
+  ckpt.update = GetUpdate() + 1;
+  ckpt.seed = config.SEED();
+  ckpt.pop_size = next.size();
+  ckpt.objective_cnt = config.OBJECTIVE_CNT();
+  ckpt.selection = config.SELECTION();
+  ckpt.diagnostic = config.DIAGNOSTIC();
+  ckpt.mutate_per = config.MUTATE_PER();
+  ckpt.mutate_mean = config.MEAN();
+  ckpt.mutate_std = config.STD();
+  ckpt.mutate_skip = config.MUTATE_SKIP();
+  ckpt.rng_streams = config.RNG_STREAMS();
+  ckpt.data_bytes = err ? 0 : size;
+  ckpt.evals = evals;
+  ckpt.obj_evals = obj_evals;
+  if(termination) {ckpt.stag_best = termination->GetStagBest(); ckpt.stag_since = termination->GetStagSince();}
+  bool seen = false;
+  sampler->GetState(seen, ckpt.sample_opt, ckpt.sample_uni);
+  ckpt.sample_seen = seen;
+  ckpt.SaveRandom(*random_ptr);
+
+  for(size_t i = 0; i < next.size(); ++i) {ckpt.AddOrg(*next[i]);}
+
+  // the lineage table already holds the offspring
+  if(lineage)
+  {
+    std::ostringstream os;
+    lineage->Save(os);
+    ckpt.lineage = os.str();
+  }
 }
 
 void DiagWorld::ReproductionStep()
 {
+  Probe t = Time(Timing::REPRODUCE);
+
   // quick checks
   emp_assert(parent_vec.size() == config.POP_SIZE());
   emp_assert(pop.size() == config.POP_SIZE());
 
+  // workers call Mutate and FinishOffspring directly and would skip any other OnOffspringReady action or mutation function,
+  // so a world that adds one goes back to the main thread (same offspring, every slot keys its own mutation stream)
+  if(pool && (offspring_ready_sig.GetNumActions() != ready_actions || fun_do_mutations.target_type() != *mut_fun_type))
+  {
+    note.Warn() << "OFFSPRING READY ACTIONS OR MUTATION FUNCTION CHANGED, REPRODUCING ON THE MAIN THREAD ONLY" << std::endl;
+    pool.Delete();
+    pool = nullptr;
+  }
+
+  // workers create the offspring instead
+  if(pool) {ParallelReproductionStep(); return;}
+
   // go through parent ids and do births
-  for(auto & id : parent_vec){DoBirth(GetGenomeAt(id), id);}
+  // offspring are copied from the parent org directly (instead of DoBirth's genome copy),
+  // so they share the parent's genome and phenotype until a mutation lands
+  for(size_t i = 0; i < parent_vec.size(); ++i)
+  {
+    const size_t id = parent_vec[i];
+    before_repro_sig.Trigger(id);
+
+    // mutations for offspring slot i come from their own stream
+    KeyStream(Stream::MUTATION, i);
+
+    emp::Ptr<Org> offspring = emp::NewPtr<Org>(*pop[id]);
+    offspring_ready_sig.Trigger(*offspring, id);
+    PlaceOffspring(offspring, id);
+  }
+}
+
+void DiagWorld::ParallelReproductionStep()
+{
+  // quick checks
+  emp_assert(pool); emp_assert(stream);
+  emp_assert(worker_muts.size() == pool->GetSize());
+  emp_assert(parent_vec.size() == config.POP_SIZE());
+  emp_assert(pop.size() == config.POP_SIZE());
+
+  // world signals stay on the main thread, so every parent gets its before_repro_sig (in slot order) up front
+  for(const size_t id : parent_vec) {before_repro_sig.Trigger(id);}
+
+  // every worker fills its own chunk of offspring slots
+  // slot i always draws from the (generation, MUTATION, i) stream, so results match the serial step
+  offspring_vec.resize(parent_vec.size());
+  pool->ParallelFor(parent_vec.size(), [this](const size_t begin, const size_t end, const size_t worker)
+  {
+    Mutation & mut = *worker_muts[worker];
+    Stream & str = *worker_streams[worker];
+
+    // the main thread waits on the workers, so the generation is safe to read
+    if(worker) {NameThread("worker " + std::to_string(worker), GetUpdate());}
+    Trace::Span span = Mark("reproduce chunk", "kernel");
+    Alloc::PhaseTag tag(Timing::REPRODUCE);
+
+    for(size_t i = begin; i < end; ++i)
+    {
+      const size_t id = parent_vec[i];
+      str.Key(GetUpdate(), Stream::MUTATION, i);
+
+      emp::Ptr<Org> offspring = emp::NewPtr<Org>(*pop[id]);
+      FinishOffspring(*offspring, id, Mutate(*offspring, mut));
+      offspring_vec[i] = offspring;
+    }
+  });
+
+  // placing offspring touches world bookkeeping, so it stays on the main thread (in slot order)
+  for(size_t i = 0; i < offspring_vec.size(); ++i) {PlaceOffspring(offspring_vec[i], parent_vec[i]);}
+  offspring_vec.clear();
 }
 
 
@@ -872,7 +1612,7 @@ void DiagWorld::ReproductionStep()
 
 void DiagWorld::MuLambda()
 {
-  std::cerr << "Setting selection scheme: MuLambda" << std::endl;
+  note.Info() << "Setting selection scheme: MuLambda" << std::endl;
 
   // set select lambda to mu lambda selection
   select = [this]()
@@ -884,15 +1624,16 @@ void DiagWorld::MuLambda()
     // group population by fitness
     fitgp_t group = selection->FitnessGroup(fit_vec);
 
+    KeyStream(Stream::SELECTION, 0);
     return selection->MLSelect(config.MU(), config.POP_SIZE(), group);
   };
 
-  std::cerr << "MuLambda selection scheme set!" << std::endl;
+  note.Info() << "MuLambda selection scheme set!" << std::endl;
 }
 
 void DiagWorld::Tournament()
 {
-  std::cerr << "Setting selection scheme: Tournament" << std::endl;
+  note.Info() << "Setting selection scheme: Tournament" << std::endl;
 
   select = [this]()
   {
@@ -906,19 +1647,20 @@ void DiagWorld::Tournament()
     // get pop size amount of parents
     for(size_t i = 0; i < parent.size(); ++i)
     {
+      KeyStream(Stream::SELECTION, i);
       parent[i] = selection->Tournament(config.TOUR_SIZE(), fit_vec);
     }
 
     return parent;
   };
 
-  std::cerr << "Tournament selection scheme set!" << std::endl;
+  note.Info() << "Tournament selection scheme set!" << std::endl;
 }
 
 void DiagWorld::FitnessSharing()
 {
-  std::cerr << "Setting selection scheme: FitnessSharing" << std::endl;
-  std::cerr << "Calculating SIGMA..." << std::endl;
+  note.Info() << "Setting selection scheme: FitnessSharing" << std::endl;
+  note.Info() << "Calculating SIGMA..." << std::endl;
 
   // calculate the sigma we are using
 
@@ -929,7 +1671,7 @@ void DiagWorld::FitnessSharing()
   // caclulate sigma
   SIGMA = selection->Pnorm(high, low, config.PNORM_EXP()) * config.FIT_SIGMA();
 
-  std::cerr << "SIGMA=" << SIGMA << std::endl;
+  note.Info() << "SIGMA=" << SIGMA << std::endl;
 
 
   select = [this]()
@@ -950,19 +1692,20 @@ void DiagWorld::FitnessSharing()
 
     for(size_t i = 0; i < parent.size(); ++i)
     {
+      KeyStream(Stream::SELECTION, i);
       parent[i] = selection->Tournament(config.TOUR_SIZE(), tscore);
     }
 
     return parent;
   };
 
-  std::cerr << "Fitness sharing selection scheme set!" << std::endl;
+  note.Info() << "Fitness sharing selection scheme set!" << std::endl;
 }
 
 void DiagWorld::NoveltySearch()
 {
-  std::cerr << "Setting selection scheme: NoveltySearch" << std::endl;
-  std::cerr << "Tournament size for novelty: " << config.TOUR_SIZE() << std::endl;
+  note.Info() << "Setting selection scheme: NoveltySearch" << std::endl;
+  note.Info() << "Tournament size for novelty: " << config.TOUR_SIZE() << std::endl;
 
   select = [this]()
   {
@@ -981,18 +1724,19 @@ void DiagWorld::NoveltySearch()
 
     for(size_t i = 0; i < parent.size(); ++i)
     {
+      KeyStream(Stream::SELECTION, i);
       parent[i] = selection->Tournament(config.TOUR_SIZE(), tscore);
     }
 
     return parent;
   };
 
-  std::cerr << "Novelty search selection scheme set!" << std::endl;
+  note.Info() << "Novelty search selection scheme set!" << std::endl;
 }
 
 void DiagWorld::EpsilonLexicase()
 {
-  std::cerr << "Setting selection scheme: EpsilonLexicase" << std::endl;
+  note.Info() << "Setting selection scheme: EpsilonLexicase" << std::endl;
 
   select = [this]()
   {
@@ -1006,20 +1750,23 @@ void DiagWorld::EpsilonLexicase()
     // select parent ids
     ids_t parent(pop.size());
 
+    Trace::Span batch;
     for(size_t i = 0; i < parent.size(); ++i)
     {
+      if(i % Trace::CHUNK == 0) {batch = Mark("lexicase batch", "kernel");}
+      KeyStream(Stream::SELECTION, i);
       parent[i] = selection->EpsiLexicase(matrix, config.LEX_EPS(), config.OBJECTIVE_CNT());
     }
 
     return parent;
   };
 
-  std::cerr << "Epsilon Lexicase selection scheme set!" << std::endl;
+  note.Info() << "Epsilon Lexicase selection scheme set!" << std::endl;
 }
 
 void DiagWorld::DownSampledLexicase()
 {
-  std::cerr << "Setting selection scheme: DownSampledLexicase" << std::endl;
+  note.Info() << "Setting selection scheme: DownSampledLexicase" << std::endl;
 
   select = [this]()
   {
@@ -1035,22 +1782,28 @@ void DiagWorld::DownSampledLexicase()
 
     // create subset of testcases to use for downsampled lexicase
     size_t subset = (double) config.OBJECTIVE_CNT() * config.DSLEX_PROP();
-    ids_t test_cases = emp::Choose(*random_ptr, config.OBJECTIVE_CNT(), subset);
+    KeyStream(Stream::DOWNSAMPLE, 0);
+    ids_t test_cases = selection->Choose(config.OBJECTIVE_CNT(), subset);
+    // everyone is only judged on the down sample
+    obj_vec.assign(pop.size(), test_cases.size());
 
+    Trace::Span batch;
     for(size_t i = 0; i < parent.size(); ++i)
     {
+      if(i % Trace::CHUNK == 0) {batch = Mark("lexicase batch", "kernel");}
+      KeyStream(Stream::SELECTION, i);
       parent[i] = selection->DSELexicase(matrix, config.LEX_EPS(), test_cases);
     }
 
     return parent;
   };
 
-  std::cerr << "Down Sampled Lexicase selection scheme set!" << std::endl;
+  note.Info() << "Down Sampled Lexicase selection scheme set!" << std::endl;
 }
 
 void DiagWorld::CohortLexicase()
 {
-  std::cerr << "Setting selection scheme: CohortLexicase" << std::endl;
+  note.Info() << "Setting selection scheme: CohortLexicase" << std::endl;
 
   select = [this]()
   {
@@ -1061,8 +1814,10 @@ void DiagWorld::CohortLexicase()
     // fitness matrix
     const fmatrix_t matrix = PopFitMat();
     // population cohorts
+    KeyStream(Stream::COHORT, 0);
     const cohort_t pop_cohorts = selection->CohortGeneration(config.POP_SIZE(), config.COH_LEX_PROP());
     // testcase cohorts
+    KeyStream(Stream::COHORT, 1);
     const cohort_t test_cohorts = selection->CohortGeneration(config.OBJECTIVE_CNT(), config.COH_LEX_PROP());
     // quick checks
     emp_assert(pop_cohorts.size() == test_cohorts.size());
@@ -1074,14 +1829,19 @@ void DiagWorld::CohortLexicase()
     size_t pnt_cnt = 0;
     for(size_t p = 0; p < pop_cohorts.size(); ++p)
     {
+      // one span per cohort
+      Trace::Span batch = Mark("lexicase batch", "kernel");
       for(size_t c = 0; c < pop_cohorts[p].size(); ++c, ++pnt_cnt)
       {
         // get winner from current cohort
+        KeyStream(Stream::SELECTION, pnt_cnt);
         size_t pnt_win = selection->CELexicase(matrix, config.LEX_EPS(), pop_cohorts[p], test_cohorts[p]);
         // quick checks; we know that POP_SIZE is our error value
         emp_assert(pnt_win != config.POP_SIZE());
         // store parent and keep going
         parent[pnt_cnt] = pnt_win;
+        // cohort members are only judged on their cohort's objectives
+        obj_vec[pop_cohorts[p][c]] = test_cohorts[p].size();
       }
     }
 
@@ -1090,12 +1850,12 @@ void DiagWorld::CohortLexicase()
     return parent;
   };
 
-  std::cerr << "Cohort Lexicase selection scheme set!" << std::endl;
+  note.Info() << "Cohort Lexicase selection scheme set!" << std::endl;
 }
 
 void DiagWorld::NoveltyLexicase()
 {
-  std::cerr << "Setting selection scheme: NoveltyLexicase" << std::endl;
+  note.Info() << "Setting selection scheme: NoveltyLexicase" << std::endl;
 
   select = [this]()
   {
@@ -1113,8 +1873,12 @@ void DiagWorld::NoveltyLexicase()
     ids_t parent(pop.size());
 
     // iterate through cohort pairing
+    Trace::Span batch;
     for(size_t i = 0; i < parent.size(); ++i)
     {
+      if(i % Trace::CHUNK == 0) {batch = Mark("lexicase batch", "kernel");}
+      KeyStream(Stream::SELECTION, i);
+
       // if K == 0, then we only expect to go to the nubmer of objectives in the problem
       if(config.NOVEL_K() == 0) {parent[i] = selection->EpsiLexicase(t_matrix, config.LEX_EPS(), config.OBJECTIVE_CNT());}
       else{parent[i] = selection->EpsiLexicase(t_matrix, config.LEX_EPS(), 2 * config.OBJECTIVE_CNT());}
@@ -1123,14 +1887,14 @@ void DiagWorld::NoveltyLexicase()
     return parent;
   };
 
-  std::cerr << "Novelty Lexicase selection scheme set!" << std::endl;
+  note.Info() << "Novelty Lexicase selection scheme set!" << std::endl;
 }
 
 ///< evaluation function implementations
 
 void DiagWorld::Exploitation()
 {
-  std::cerr << "Setting exploitation diagnostic..." << std::endl;
+  note.Info() << "Setting exploitation diagnostic..." << std::endl;
 
   evaluate = [this](Org & org)
   {
@@ -1148,12 +1912,12 @@ void DiagWorld::Exploitation()
     return org.GetAggregate();
   };
 
-  std::cerr << "Exploitation diagnotic set!" << std::endl;
+  note.Info() << "Exploitation diagnotic set!" << std::endl;
 }
 
 void DiagWorld::StructuredExploitation()
 {
-  std::cerr << "Setting structured exploitation diagnostic..." << std::endl;
+  note.Info() << "Setting structured exploitation diagnostic..." << std::endl;
 
   evaluate = [this](Org & org)
   {
@@ -1171,12 +1935,12 @@ void DiagWorld::StructuredExploitation()
     return org.GetAggregate();
   };
 
-  std::cerr << "Structured exploitation diagnotic set!" << std::endl;
+  note.Info() << "Structured exploitation diagnotic set!" << std::endl;
 }
 
 void DiagWorld::StrongEcology()
 {
-  std::cerr << "Setting strong ecology diagnostic..." << std::endl;
+  note.Info() << "Setting strong ecology diagnostic..." << std::endl;
 
   evaluate = [this](Org & org)
   {
@@ -1194,12 +1958,12 @@ void DiagWorld::StrongEcology()
     return org.GetAggregate();
   };
 
-  std::cerr << "Strong ecology diagnotic set!" << std::endl;
+  note.Info() << "Strong ecology diagnotic set!" << std::endl;
 }
 
 void DiagWorld::Exploration()
 {
-  std::cerr << "Setting exploration diagnostic..." << std::endl;
+  note.Info() << "Setting exploration diagnostic..." << std::endl;
 
   evaluate = [this](Org & org)
   {
@@ -1217,12 +1981,12 @@ void DiagWorld::Exploration()
     return org.GetAggregate();
   };
 
-  std::cerr << "Exploration diagnotic set!" << std::endl;
+  note.Info() << "Exploration diagnotic set!" << std::endl;
 }
 
 void DiagWorld::WeakEcology()
 {
-  std::cerr << "Setting weak ecology diagnostic..." << std::endl;
+  note.Info() << "Setting weak ecology diagnostic..." << std::endl;
 
   evaluate = [this](Org & org)
   {
@@ -1240,194 +2004,180 @@ void DiagWorld::WeakEcology()
     return org.GetAggregate();
   };
 
-  std::cerr << "Weak ecology diagnotic set!" << std::endl;
+  note.Info() << "Weak ecology diagnotic set!" << std::endl;
 }
 
-///< data tracking
+///< helper functions
 
-size_t DiagWorld::UniqueObjective()
+DiagWorld::fmatrix_t DiagWorld::PopFitMat()
 {
   // quick checks
-  emp_assert(0 < pop.size()); emp_assert(pop.size() == config.POP_SIZE());
+  emp_assert(pop.size() == config.POP_SIZE());
 
-  // iterate through objectives
-  size_t cnt = 0;
-  for(size_t o = 0; o < config.OBJECTIVE_CNT(); ++o)
-  {
-    // iterate pop to check is a solution has the objective optimized
-    for(size_t p = 0; p < pop.size(); ++p)
-    {
-      Org & org = *pop[p];
+  // create matrix of population score vectors
+  Alloc::SiteTag site(Alloc::MATRIX);
+  fmatrix_t matrix(pop.size());
 
-      // quick checks
-      emp_assert(org.GetOptimal().size() == config.OBJECTIVE_CNT());
+  for(size_t i = 0; i < pop.size(); ++i)
+  {
+    Org & org = *pop[i];
+    emp_assert(org.GetScore().size() == config.OBJECTIVE_CNT());
 
-      if(org.OptimizedAt(o))
-      {
-        ++cnt;
-        break;
-      }
-    }
+    // charles ask if this is the actual org score vector or a deep copy made
+    matrix[i] = org.GetScore();
   }
 
-  return cnt;
-}
-
-size_t DiagWorld::FindElite()
-{
-  // quick checks
-  emp_assert(0 < fit_vec.size()); emp_assert(fit_vec.size() == pop.size());
-  emp_assert(fit_vec.size() == config.POP_SIZE());
-  emp_assert(elite_pos == config.POP_SIZE());
-
-  // find max value position
-  auto elite_it = std::max_element(fit_vec.begin(), fit_vec.end());
-
-  return std::distance(fit_vec.begin(), elite_it);;
+  return matrix;
 }
 
-size_t DiagWorld::FindCommon()
+DiagWorld::gmatrix_t DiagWorld::PopGenomes()
 {
   // quick checks
   emp_assert(pop.size() == config.POP_SIZE());
-  emp_assert(common.size() == 0);
-  emp_assert(comm_pos == config.POP_SIZE());
 
-  // iterate through pop and place in appropiate bin
+  Alloc::SiteTag site(Alloc::MATRIX);
+  gmatrix_t matrix(pop.size());
+
   for(size_t i = 0; i < pop.size(); ++i)
   {
-    bool in_comm = false;
-    const Org & org = *pop[i];
-
-    // check if current org matches any of the existing keys
-    for(const auto & p : common)
-    {
-      // get key orgs data
-      const Org & korg = *pop[p.first];
-
-      // get euclidean distance between both genomes
-      const double dif = selection->Pnorm(org.GetGenome(), korg.GetGenome(), 2.0);
-
-      // if they are a match
-      if(dif == 0.0)
-      {
-        common[p.first].push_back(i);
-        in_comm = true;
-        break;
-      }
-    }
-
-    if(!in_comm)
-    {
-      ids_t first{i};
-      common[i] = first;
-    }
-  }
+    Org & org = *pop[i];
+    emp_assert(org.GetGenome().size() == config.OBJECTIVE_CNT());
 
-  // iterate through common dictionary and find common org id
-  size_t max = 0; size_t max_pos = 0;
-  for(const auto & p : common)
-  {
-    if(max < p.second.size())
-    {
-      max_pos = p.first;
-      max = p.second.size();
-    }
+    // charles ask if this is the actual org genome or a deep copy made
+    matrix[i] = org.GetGenome();
   }
 
-  return max_pos;
+  return matrix;
 }
 
-size_t DiagWorld::FindOptimized()
+emp::vector<Org> DiagWorld::Emigrate(const size_t cnt, const bool elite)
 {
   // quick checks
-  emp_assert(0 < pop.size()); emp_assert(pop.size() == config.POP_SIZE());
-  emp_assert(opti_pos == config.POP_SIZE());
+  emp_assert(cnt <= pop.size()); emp_assert(fit_vec.size() == pop.size());
 
-  // iterate through pop and find optimal solution
-  size_t max = 0; size_t max_pos = 0;
-  for(size_t i = 0; i < pop.size(); ++i)
+  ids_t ids;
+  if(elite)
   {
-    const Org & org = *pop[i];
-
-    if(max < org.GetCount())
-    {
-      max = org.GetCount();
-      max_pos = i;
-    }
+    ids.resize(pop.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    std::stable_sort(ids.begin(), ids.end(), [this](size_t a, size_t b) {return fit_vec[a] > fit_vec[b];});
+    ids.resize(cnt);
+  }
+  else
+  {
+    KeyStream(Stream::MIGRATION, 0);
+    ids = selection->Choose(pop.size(), cnt);
   }
 
-  return max_pos;
+  emp::vector<Org> orgs;
+  for(auto id : ids) {orgs.push_back(*pop[id]);}
+
+  return orgs;
 }
 
-size_t DiagWorld::FindUniqueStart()
+void DiagWorld::Immigrate(const emp::vector<Org> & orgs)
 {
   // quick checks
-  emp_assert(0 < pop.size()); emp_assert(pop.size() == config.POP_SIZE());
+  emp_assert(orgs.size() <= pop.size()); emp_assert(fit_vec.size() == pop.size());
 
-  // collect number of unique starting positions
-  std::set<size_t> position;
+  ids_t ids(pop.size());
+  std::iota(ids.begin(), ids.end(), 0);
+  std::stable_sort(ids.begin(), ids.end(), [this](size_t a, size_t b) {return fit_vec[a] < fit_vec[b];});
 
-  // iterate pop to check is a solution has the objective optimized
-  for(size_t p = 0; p < pop.size(); ++p)
+  for(size_t i = 0; i < orgs.size(); ++i)
   {
-    Org & org = *pop[p];
-
-    // check that the position has be set
-    emp_assert(org.GetStart() != config.OBJECTIVE_CNT());
+    const size_t id = ids[i];
+    emp::Ptr<Org> org = emp::NewPtr<Org>(orgs[i]);
+    fit_vec[id] = org->GetAggregate();
+    AddOrgAt(org, id);
 
-    // insert position into set
-    position.insert(org.GetStart());
+    // immigrants come from another world's tree, so they start a root here
+    if(lineage) {lineage->Arrive(id, GetUpdate()); lineage->Record(id, org->GetAggregate(), org->GetScore());}
   }
-
-  return position.size();
 }
 
-// void DiagWorld::SnapshotPhylogony()
-// {
-//   sys_ptr->Snapshot(config.OUTPUT_DIR() + "phylo_" + emp::to_string(GetUpdate()) + ".csv");
-// }
+void DiagWorld::Immigrate(const gmatrix_t & genomes)
+{
+  emp::vector<Org> orgs;
+  for(const auto & g : genomes)
+  {
+    // quick checks
+    emp_assert(g.size() == config.OBJECTIVE_CNT());
 
+    orgs.emplace_back(g);
+    evaluate(orgs.back());
+    ++evals;
+    // immigrants arrive after this island's evaluation step, so they are charged every objective
+    obj_evals += config.OBJECTIVE_CNT();
+  }
 
-///< helper functions
+  Immigrate(orgs);
+}
 
-DiagWorld::fmatrix_t DiagWorld::PopFitMat()
+size_t DiagWorld::Mutate(Org & org, Mutation & mut)
 {
-  // quick checks
-  emp_assert(pop.size() == config.POP_SIZE());
+  if(config.MUTATE_SKIP()) {return mut.Skip(org, target, config.MUTATE_PER(), config.MEAN(), config.STD());}
 
-  // create matrix of population score vectors
-  fmatrix_t matrix(pop.size());
+  return mut.PerGene(org, target, config.MUTATE_PER(), config.MEAN(), config.STD());
+}
 
-  for(size_t i = 0; i < pop.size(); ++i)
+void DiagWorld::FinishOffspring(Org & org, const size_t parent_pos, const size_t mcnt)
+{
+  // no mutations were applied to offspring
+  if(mcnt == 0)
   {
-    Org & org = *pop[i];
-    emp_assert(org.GetScore().size() == config.OBJECTIVE_CNT());
+    // quick checks
+    emp_assert(org.SharedGenome());
+    emp_assert(pop[parent_pos]->GetGenome() == org.GetGenome());
 
-    // charles ask if this is the actual org score vector or a deep copy made
-    matrix[i] = org.GetScore();
+    // offspring is a copy of its parent, so it already shares everything with it
+    org.MeClone();
   }
-
-  return matrix;
+  else{org.Reset();}
 }
 
-DiagWorld::gmatrix_t DiagWorld::PopGenomes()
+void DiagWorld::PlaceOffspring(emp::Ptr<Org> offspring, const size_t parent_pos)
 {
   // quick checks
-  emp_assert(pop.size() == config.POP_SIZE());
+  emp_assert(offspring); emp_assert(fun_find_birth_pos);
 
-  gmatrix_t matrix(pop.size());
+  const emp::WorldPosition pos = fun_find_birth_pos(offspring, parent_pos);
+  if(pos.IsValid()) {AddOrgAt(offspring, pos, parent_pos);}
+  else {offspring.Delete();}
+}
 
-  for(size_t i = 0; i < pop.size(); ++i)
-  {
-    Org & org = *pop[i];
-    emp_assert(org.GetGenome().size() == config.OBJECTIVE_CNT());
+void DiagWorld::SnapshotTermination()
+{
+  // quick checks
+  emp_assert(termination);
+
+  const std::string reason = stop_reason.empty() ? "max_gens" : stop_reason;
+
+  emp::DataFile file(config.OUTPUT_DIR() + "termination.csv");
+  // the generation the criterion fired (islands run on to their common last generation)
+  const size_t gen = stop_reason.empty() ? census.update : stop_update;
+  file.AddFun<size_t>([&gen]() {return gen;}, "gen", "Generation the run stopped at!");
+  file.AddFun<std::string>([&reason]() {return reason;}, "reason", "Why the run stopped!");
+  file.AddFun<size_t>([this]() {return census.evals;}, "sol_evals", "Solutions evaluated!");
+  file.AddFun<size_t>([this]() {return census.obj_evals;}, "obj_evals", "Objective evaluations!");
+  file.PrintHeaderKeys();
+  file.Update();
+}
 
-    // charles ask if this is the actual org genome or a deep copy made
-    matrix[i] = org.GetGenome();
-  }
+template <typename T>
+void DiagWorld::AddColumn(const std::function<T()> & fun, const std::string & key, const std::string & desc)
+{
+  if(config.DATA_FORMAT() != 1) {data_file.AddFun<T>(fun, key, desc);}
+  if(columns) {columns->Add<T>(fun, key, desc);}
+}
 
-  return matrix;
+void DiagWorld::WriteRow()
+{
+  // may run on the pipe thread, so the generation comes from the census
+  Trace::Span span = Mark("write row", "io", census.update);
+
+  if(config.DATA_FORMAT() != 1) {data_file.Update();}
+  if(columns) {columns->Update();}
 }
 
 void DiagWorld::SnapshotConfig(const config_t & config) {
@@ -0,0 +1,291 @@
+/// Asynchronous file output: rows are formatted on the calling thread, pushed into a lock-free ring buffer,
+/// and a dedicated writer thread drains it with batched write calls, so a slow filesystem never stalls a generation
+/// The producer only blocks when the ring is full (back-pressure), and everything is written before the file closes
+
+#ifndef WRITER_H
+#define WRITER_H
+
+///< standard headers
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+///< system headers
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+///< empirical headers
+#include "base/vector.h"
+
+/// Single producer, single consumer byte ring (capacity is a power of two)
+class Ring
+{
+  public:
+
+    Ring(const size_t _cap) : cap(Round(_cap)), mask(cap - 1), data(cap) {;}
+
+    ///< producer side
+
+    // copy in as much of [src, src + n) as fits, returns the bytes taken
+    size_t Push(const char * src, const size_t n);
+
+    ///< consumer side
+
+    // bytes waiting, handed out as at most two contiguous spans
+    size_t Peek(const char * & a, size_t & na, const char * & b, size_t & nb) const;
+
+    // drop n bytes from the front
+    void Pop(const size_t n) {tail.store(tail.load(std::memory_order_relaxed) + n, std::memory_order_release);}
+
+    ///< either side
+
+    size_t GetCapacity() const {return cap;}
+    size_t GetSize() const {return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);}
+
+  private:
+    // smallest power of two >= n (at least 64 bytes)
+    static size_t Round(const size_t n) {size_t c = 64; while(c < n) {c <<= 1;} return c;}
+
+    const size_t cap;
+    const size_t mask;
+    emp::vector<char> data;
+
+    // total bytes ever pushed (producer) and popped (consumer), on their own cache lines
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+size_t Ring::Push(const char * src, const size_t n)
+{
+  const size_t h = head.load(std::memory_order_relaxed);
+  const size_t free = cap - (h - tail.load(std::memory_order_acquire));
+  const size_t take = std::min(n, free);
+  if(take == 0) {return 0;}
+
+  // copy in up to two pieces around the wrap
+  const size_t at = h & mask;
+  const size_t first = std::min(take, cap - at);
+  std::memcpy(data.data() + at, src, first);
+  std::memcpy(data.data(), src + first, take - first);
+
+  head.store(h + take, std::memory_order_release);
+  return take;
+}
+
+size_t Ring::Peek(const char * & a, size_t & na, const char * & b, size_t & nb) const
+{
+  const size_t t = tail.load(std::memory_order_relaxed);
+  const size_t n = head.load(std::memory_order_acquire) - t;
+
+  const size_t at = t & mask;
+  a = data.data() + at; na = std::min(n, cap - at);
+  b = data.data(); nb = n - na;
+
+  return n;
+}
+
+class AsyncFile : public std::streambuf
+{
+  public:
+
+    /**
+     * Constructor:
+     *
+     * Opens the file and starts its writer thread.
+     *
+     * @param path File to write.
+     * @param capacity Ring buffer bytes (the producer waits once this much is still unwritten).
+     * @param append Keep what the file holds and add after it (resuming a run)?
+     */
+    AsyncFile(const std::string & path, const size_t capacity, const bool append = false);
+
+    // writes everything still buffered, then joins the writer thread
+    ~AsyncFile();
+
+    ///< helper functions
+
+    // stream formatting into this file
+    std::ostream & GetStream() {return stream;}
+
+    // did the file open, and has every write so far gone through?
+    bool Good() const {return 0 <= fd && !failed.load();}
+
+    // block until everything handed over so far is written out
+    void Flush();
+
+    // times the producer had to wait on a full ring
+    size_t GetStalls() const {return stalls;}
+
+  protected:
+    ///< std::streambuf hooks (the put area is a small local buffer, handed to the ring whole)
+
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+  private:
+    // hand the local buffer to the ring (waits while the ring is full)
+    void Hand();
+
+    // loop run by the writer thread
+    void Work();
+
+    // write everything the ring holds with as few write calls as possible
+    void Drain();
+
+  private:
+    // output file
+    int fd = -1;
+    std::string path;
+
+    // local buffer rows are formatted into
+    emp::vector<char> local;
+    std::ostream stream;
+
+    // handed over bytes
+    Ring ring;
+    size_t stalls = 0;
+
+    // sleeping and waking (the data path itself never takes the lock)
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> failed{false};
+
+    // writer thread (started last, once everything above exists)
+    std::thread thread;
+};
+
+AsyncFile::AsyncFile(const std::string & _path, const size_t capacity, const bool append)
+  : path(_path), local(4096), stream(this), ring(capacity)
+{
+  fd = ::open(path.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+  if(fd < 0)
+  {
+    std::cerr << "ERROR: COULD NOT OPEN " << path << ": " << std::strerror(errno) << std::endl;
+    stream.setstate(std::ios::badbit);
+  }
+
+  setp(local.data(), local.data() + local.size());
+  thread = std::thread(&AsyncFile::Work, this);
+}
+
+AsyncFile::~AsyncFile()
+{
+  Hand();
+  stop.store(true);
+  {
+    std::lock_guard<std::mutex> guard(lock);
+  }
+  wake.notify_one();
+  thread.join();
+
+  if(0 <= fd) {::close(fd);}
+}
+
+void AsyncFile::Flush()
+{
+  Hand();
+  wake.notify_one();
+
+  std::unique_lock<std::mutex> guard(lock);
+  drained.wait(guard, [this]() {return ring.GetSize() == 0;});
+}
+
+AsyncFile::int_type AsyncFile::overflow(int_type ch)
+{
+  Hand();
+  if(!traits_type::eq_int_type(ch, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+
+  return traits_type::not_eof(ch);
+}
+
+int AsyncFile::sync()
+{
+  // a flushed row goes to the writer thread, not to the disk
+  Hand();
+  wake.notify_one();
+
+  return 0;
+}
+
+void AsyncFile::Hand()
+{
+  const char * src = pbase();
+  size_t n = pptr() - pbase();
+
+  while(0 < n)
+  {
+    const size_t took = ring.Push(src, n);
+    src += took; n -= took;
+    if(n == 0) {break;}
+
+    // back-pressure: the writer is behind by a whole ring, wait for it to catch up
+    ++stalls;
+    wake.notify_one();
+    std::unique_lock<std::mutex> guard(lock);
+    drained.wait_for(guard, std::chrono::milliseconds(1), [this]() {return ring.GetSize() < ring.GetCapacity();});
+  }
+
+  setp(local.data(), local.data() + local.size());
+}
+
+void AsyncFile::Work()
+{
+  while(true)
+  {
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      wake.wait_for(guard, std::chrono::milliseconds(50), [this]() {return stop.load() || 0 < ring.GetSize();});
+    }
+
+    Drain();
+    // taking the lock first means a waiter cannot miss this
+    {
+      std::lock_guard<std::mutex> guard(lock);
+    }
+    drained.notify_all();
+
+    if(stop.load() && ring.GetSize() == 0) {break;}
+  }
+}
+
+void AsyncFile::Drain()
+{
+  const char * a; const char * b; size_t na, nb;
+  while(0 < ring.Peek(a, na, b, nb))
+  {
+    const size_t n = na + nb;
+
+    // a broken file still empties the ring, so the producer never hangs on it
+    if(fd < 0 || failed.load()) {ring.Pop(n); continue;}
+
+    // both spans in one call
+    iovec iov[2] = {{const_cast<char *>(a), na}, {const_cast<char *>(b), nb}};
+    const ssize_t wrote = ::writev(fd, iov, (nb == 0) ? 1 : 2);
+    if(wrote < 0)
+    {
+      if(errno == EINTR) {continue;}
+      std::cerr << "ERROR: COULD NOT WRITE " << path << ": " << std::strerror(errno) << std::endl;
+      failed.store(true);
+      continue;
+    }
+
+    ring.Pop(static_cast<size_t>(wrote));
+  }
+}
+
+#endif